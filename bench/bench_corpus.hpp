@@ -0,0 +1,375 @@
+/*
+ * jsontree - JSON Parsing and library in C++20
+ * Copyright 2025 Marcin Markiewicz, marcin.kivrin@gmail.com
+ *
+ * This file is a part of jsontree project
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * Project: jsontree
+ *
+ */
+
+#ifndef __jsontree__bench_corpus_hpp
+#define __jsontree__bench_corpus_hpp
+
+
+#include <charconv>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+#include "jsontree.hpp"
+#include "jsontree_writer.hpp"
+
+
+struct BenchCorpus {
+    std::string name;
+    std::string json_data;
+};
+
+/**
+ * Synthetic documents of typical shapes, generated locally. Generator is seeded and std::mt19937_64 gives the
+ * same numbers on every platform, so documents are the same between runs and versions. Documents are minified,
+ * each one is generated until it has at least target_size bytes.
+ */
+class BenchCorpusGenerator {
+    std::mt19937_64 random{42};
+    std::string json_data{};
+
+    uint64_t next(const uint64_t limit) { return random() % limit; }
+
+    void add_int(const int64_t value) { json_data += std::to_string(value); }
+
+    void add_double(const double value) {
+        char buffer[32];
+        const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        json_data.append(buffer, result.ptr);
+    }
+
+    void add_word() {
+        static constexpr std::string_view syllables[] = {"ka", "ri", "lo", "men", "tas", "vi", "dor", "el",
+                                                         "yn", "qu", "sha", "po", "ber", "ix", "ul", "zen"};
+        for (auto count = 1 + next(3); count > 0; --count) {
+            json_data += syllables[next(std::size(syllables))];
+        }
+    }
+
+    /**
+     * Text of words with some escape sequences and multibyte characters
+     */
+    void add_text(const size_t words) {
+        json_data += '"';
+        for (size_t i = 0; i < words; ++i) {
+            if (i > 0) { json_data += ' '; }
+            switch (next(24)) {
+            case 0:
+                json_data += "\\\"quoted\\\"";
+                break;
+            case 1:
+                json_data += "line\\nbreak";
+                break;
+            case 2:
+                json_data += "\\u00e9t\\u00e9";
+                break;
+            case 3:
+                json_data += "\xe6\x97\xa5\xe6\x9c\xac"; // UTF-8
+                break;
+            default:
+                add_word();
+            }
+        }
+        json_data += '"';
+    }
+
+    void add_key(const std::string_view key) {
+        json_data += '"';
+        json_data += key;
+        json_data += "\":";
+    }
+
+    void add_nested(size_t depth);
+    void add_wide_object(size_t keys);
+    void add_polygon(size_t points);
+    void add_status();
+    void add_event(uint64_t id);
+    void add_performance(uint64_t event_id);
+
+public:
+    std::string deep_nesting(size_t target_size);
+    std::string wide_objects(size_t target_size);
+    std::string numeric_arrays(size_t target_size);
+    std::string strings(size_t target_size);
+    std::string twitter(size_t target_size);
+    std::string citm(size_t target_size);
+};
+
+inline void BenchCorpusGenerator::add_nested(const size_t depth) {
+    if (depth == 0) {
+        add_int(static_cast<int64_t>(next(1000)));
+        return;
+    }
+    if (depth % 2 == 0) {
+        json_data += "{\"level\":";
+        add_nested(depth - 1);
+        json_data += '}';
+    } else {
+        json_data += '[';
+        add_nested(depth - 1);
+        json_data += ']';
+    }
+}
+
+inline std::string BenchCorpusGenerator::deep_nesting(const size_t target_size) {
+    json_data = "[";
+    while (json_data.size() < target_size) {
+        if (json_data.size() > 1) { json_data += ','; }
+        add_nested(32 + next(64));
+    }
+    json_data += ']';
+    return std::move(json_data);
+}
+
+inline void BenchCorpusGenerator::add_wide_object(const size_t keys) {
+    json_data += '{';
+    for (size_t i = 0; i < keys; ++i) {
+        if (i > 0) { json_data += ','; }
+        add_key("field_" + std::to_string(i));
+        switch (i % 5) {
+        case 0:
+            add_int(static_cast<int64_t>(next(1000000)));
+            break;
+        case 1:
+            json_data += '"';
+            add_word();
+            json_data += '"';
+            break;
+        case 2:
+            json_data += next(2) ? "true" : "false";
+            break;
+        case 3:
+            json_data += "null";
+            break;
+        default:
+            add_double(static_cast<double>(next(1000000)) / 1000.0);
+        }
+    }
+    json_data += '}';
+}
+
+inline std::string BenchCorpusGenerator::wide_objects(const size_t target_size) {
+    json_data = "[";
+    while (json_data.size() < target_size) {
+        if (json_data.size() > 1) { json_data += ','; }
+        add_wide_object(1000);
+    }
+    json_data += ']';
+    return std::move(json_data);
+}
+
+inline void BenchCorpusGenerator::add_polygon(const size_t points) {
+    json_data += R"({"type":"Feature","properties":{"name":")";
+    add_word();
+    json_data += R"("},"geometry":{"type":"Polygon","coordinates":[[)";
+    for (size_t i = 0; i < points; ++i) {
+        if (i > 0) { json_data += ','; }
+        json_data += '[';
+        add_double(-180.0 + static_cast<double>(random() >> 11) * 0x1p-53 * 360.0);
+        json_data += ',';
+        add_double(-90.0 + static_cast<double>(random() >> 11) * 0x1p-53 * 180.0);
+        json_data += ']';
+    }
+    json_data += "]]}}";
+}
+
+inline std::string BenchCorpusGenerator::numeric_arrays(const size_t target_size) {
+    json_data = R"({"type":"FeatureCollection","features":[)";
+    while (json_data.size() < target_size) {
+        if (json_data.back() != '[') { json_data += ','; }
+        add_polygon(100 + next(1000));
+    }
+    json_data += R"(],"counts":[)";
+    for (size_t i = 0; i < 10000; ++i) {
+        if (i > 0) { json_data += ','; }
+        add_int(static_cast<int64_t>(next(1ull << 40)) - (1ll << 39));
+    }
+    json_data += "]}";
+    return std::move(json_data);
+}
+
+inline std::string BenchCorpusGenerator::strings(const size_t target_size) {
+    json_data = "[";
+    for (int64_t id = 0; json_data.size() < target_size; ++id) {
+        if (json_data.size() > 1) { json_data += ','; }
+        json_data += "{\"id\":";
+        add_int(id);
+        json_data += ",\"title\":";
+        add_text(1 + next(8));
+        json_data += ",\"body\":";
+        add_text(20 + next(400));
+        json_data += '}';
+    }
+    json_data += ']';
+    return std::move(json_data);
+}
+
+/**
+ * Status of twitter.json shape: big ids, nested user and entities, many nulls and booleans
+ */
+inline void BenchCorpusGenerator::add_status() {
+    const auto id = 505874924095815681ull + next(1ull << 32);
+    json_data += R"({"metadata":{"result_type":"recent","iso_language_code":"ja"},)"
+                 R"("created_at":"Sun Aug 31 00:29:15 +0000 2014","id":)";
+    json_data += std::to_string(id);
+    json_data += ",\"id_str\":\"" + std::to_string(id) + "\",\"text\":";
+    add_text(5 + next(25));
+    json_data += R"(,"source":"<a href=\"http://twitter.com/download/iphone\" rel=\"nofollow\">Twitter for iPhone</a>)"
+                 R"(","truncated":false,"in_reply_to_status_id":null,"in_reply_to_user_id":null,"user":{"id":)";
+    add_int(static_cast<int64_t>(next(3000000000)));
+    json_data += ",\"name\":";
+    add_text(1 + next(2));
+    json_data += ",\"screen_name\":\"";
+    add_word();
+    json_data += R"(","location":"","description":)";
+    add_text(next(20));
+    json_data += R"(,"url":null,"entities":{"description":{"urls":[]}},"protected":false,"followers_count":)";
+    add_int(static_cast<int64_t>(next(100000)));
+    json_data += ",\"friends_count\":";
+    add_int(static_cast<int64_t>(next(10000)));
+    json_data += R"(,"created_at":"Thu Jul 11 10:03:55 +0000 2013","favourites_count":)";
+    add_int(static_cast<int64_t>(next(10000)));
+    json_data += R"(,"utc_offset":null,"time_zone":null,"geo_enabled":false,"verified":false,"statuses_count":)";
+    add_int(static_cast<int64_t>(next(100000)));
+    json_data += R"(,"lang":"ja","profile_image_url":"http:\/\/pbs.twimg.com\/profile_images\/1\/normal.jpeg",)"
+                 R"("default_profile":true},"geo":null,"coordinates":null,"place":null,"retweet_count":)";
+    add_int(static_cast<int64_t>(next(100)));
+    json_data += R"(,"favorite_count":0,"entities":{"hashtags":[],"symbols":[],"urls":[],"user_mentions":[)";
+    const auto mentions = next(3);
+    for (uint64_t i = 0; i < mentions; ++i) {
+        if (i > 0) { json_data += ','; }
+        json_data += "{\"screen_name\":\"";
+        add_word();
+        json_data += "\",\"id\":";
+        add_int(static_cast<int64_t>(next(3000000000)));
+        json_data += ",\"indices\":[0,";
+        add_int(static_cast<int64_t>(3 + next(12)));
+        json_data += "]}";
+    }
+    json_data += R"(]},"favorited":false,"retweeted":false,"lang":"ja"})";
+}
+
+inline std::string BenchCorpusGenerator::twitter(const size_t target_size) {
+    json_data = R"({"statuses":[)";
+    while (json_data.size() < target_size) {
+        if (json_data.back() != '[') { json_data += ','; }
+        add_status();
+    }
+    json_data += R"(],"search_metadata":{"completed_in":0.087,"max_id":505874924095815681,"query":"%E4%B8%80",)"
+                 R"("count":100,"since_id":0}})";
+    return std::move(json_data);
+}
+
+/**
+ * Event of citm_catalog.json shape: objects keyed by numeric ids, small integer arrays, many nulls
+ */
+inline void BenchCorpusGenerator::add_event(const uint64_t id) {
+    json_data += "\"" + std::to_string(id) + R"(":{"description":null,"id":)" + std::to_string(id);
+    json_data += R"(,"logo":null,"name":)";
+    add_text(1 + next(4));
+    json_data += R"(,"subTopicIds":[337184269,337184283],"subjectCode":null,"subtitle":null,"topicIds":[)";
+    add_int(static_cast<int64_t>(324846099 + next(1000)));
+    json_data += ",107888604]}";
+}
+
+inline void BenchCorpusGenerator::add_performance(const uint64_t event_id) {
+    json_data += R"({"eventId":)" + std::to_string(event_id) + R"(,"id":)";
+    add_int(static_cast<int64_t>(339887544 + next(1000000)));
+    json_data += R"(,"logo":null,"name":null,"prices":[)";
+    const auto categories = 1 + next(4);
+    for (uint64_t i = 0; i < categories; ++i) {
+        if (i > 0) { json_data += ','; }
+        json_data += R"({"amount":)";
+        add_int(static_cast<int64_t>(10000 + next(100) * 250));
+        json_data += R"(,"audienceSubCategoryId":337100890,"seatCategoryId":)";
+        add_int(static_cast<int64_t>(338937295 + i));
+        json_data += '}';
+    }
+    json_data += R"(],"seatCategories":[)";
+    for (uint64_t i = 0; i < categories; ++i) {
+        if (i > 0) { json_data += ','; }
+        json_data += R"({"areas":[{"areaId":205705999,"blockIds":[]},{"areaId":205705998,"blockIds":[]}],)"
+                     R"("seatCategoryId":)";
+        add_int(static_cast<int64_t>(338937295 + i));
+        json_data += '}';
+    }
+    json_data += R"(],"seatMapImage":null,"start":)";
+    add_int(static_cast<int64_t>(1372608000000 + next(1000000000)));
+    json_data += R"(,"venueCode":"PLEYEL_PLEYEL"})";
+}
+
+inline std::string BenchCorpusGenerator::citm(const size_t target_size) {
+    json_data = R"({"areaNames":{"205705993":"Arrière-scène central","205705994":"1er balcon central",)"
+                R"("205705995":"2ème balcon bergerie cour"},"events":{)";
+    // half of the document are events, the other half performances of them
+    const auto first_event = uint64_t{138586341};
+    auto last_event = first_event;
+    for (; json_data.size() < target_size / 2; ++last_event) {
+        if (last_event > first_event) { json_data += ','; }
+        add_event(last_event);
+    }
+    json_data += R"(},"performances":[)";
+    while (json_data.size() < target_size) {
+        if (json_data.back() != '[') { json_data += ','; }
+        add_performance(first_event + next(last_event - first_event));
+    }
+    json_data += R"(],"venueNames":{"PLEYEL_PLEYEL":"Salle Pleyel"}})";
+    return std::move(json_data);
+}
+
+/**
+ * Generate synthetic documents one by one, minified and pretty printed, and pass each one to use(corpus). Only
+ * one document is kept in memory at a time, so it does not hide memory used by parsing.
+ */
+template <typename Use>
+void for_each_bench_corpus(const size_t target_size, Use&& use) {
+    using Generate = std::string (BenchCorpusGenerator::*)(size_t);
+    static constexpr std::pair<std::string_view, Generate> shapes[] = {
+        {"deep nesting", &BenchCorpusGenerator::deep_nesting},
+        {"wide objects", &BenchCorpusGenerator::wide_objects},
+        {"numeric arrays", &BenchCorpusGenerator::numeric_arrays},
+        {"strings", &BenchCorpusGenerator::strings},
+        {"twitter", &BenchCorpusGenerator::twitter},
+        {"citm", &BenchCorpusGenerator::citm},
+    };
+    BenchCorpusGenerator generator;
+    for (const auto& [name, generate] : shapes) {
+        BenchCorpus corpus{std::string(name) + ", minified", (generator.*generate)(target_size)};
+        use(static_cast<const BenchCorpus&>(corpus));
+        std::string pretty_data{};
+        {
+            JsonTree tree(corpus.json_data);
+            if (tree.parse({.decode_escapes = false})) {
+                pretty_data = json_write(tree, {.pretty = true});
+            }
+        }
+        // minified document is released before the pretty one is used
+        corpus = {std::string(name) + ", pretty", std::move(pretty_data)};
+        if (!corpus.json_data.empty()) {
+            use(static_cast<const BenchCorpus&>(corpus));
+        }
+    }
+}
+
+#endif //__jsontree__bench_corpus_hpp
@@ -0,0 +1,876 @@
+/*
+ * jsontree - JSON Parsing and library in C++20
+ * Copyright 2025 Marcin Markiewicz, marcin.kivrin@gmail.com
+ *
+ * This file is a part of jsontree project
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * Project: jsontree
+ *
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "bench_corpus.hpp"
+#include "jsontree.hpp"
+#include "jsontree_cache.hpp"
+#include "jsontree_cursor.hpp"
+#include "jsontree_edit.hpp"
+#include "jsontree_image.hpp"
+#include "jsontree_lines.hpp"
+#include "jsontree_parallel.hpp"
+#include "jsontree_parser.hpp"
+#include "jsontree_bind.hpp"
+#include "jsontree_tools.hpp"
+#include "jsontree_writer.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+
+// every allocation of the process is counted, so benchmarks can report allocations per document. All forms of
+// operator new and delete are replaced, memory comes from malloc and goes back through bench_deallocate, which is
+// not inlined, so the compiler does not see free of memory returned by new.
+std::atomic<size_t> allocations_count{0};
+
+[[gnu::noinline]] void* bench_allocate(const size_t size, const std::align_val_t alignment) noexcept {
+    allocations_count.fetch_add(1, std::memory_order_relaxed);
+    const auto align = static_cast<size_t>(alignment);
+    if (align <= __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+        return std::malloc(size > 0 ? size : 1);
+    }
+    // over aligned memory keeps pointer returned by malloc right before it
+    const auto memory = static_cast<char*>(std::malloc(size + align));
+    if (memory == nullptr) {
+        return nullptr;
+    }
+    const auto aligned = memory + align - reinterpret_cast<uintptr_t>(memory) % align;
+    std::memcpy(aligned - sizeof(memory), &memory, sizeof(memory));
+    return aligned;
+}
+
+[[gnu::noinline]] void bench_deallocate(void* memory, const std::align_val_t alignment) noexcept {
+    if (memory != nullptr && static_cast<size_t>(alignment) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+        std::memcpy(&memory, static_cast<char*>(memory) - sizeof(memory), sizeof(memory));
+    }
+    std::free(memory);
+}
+
+void* bench_allocate_or_throw(const size_t size, const std::align_val_t alignment) {
+    if (const auto memory = bench_allocate(size, alignment)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+constexpr auto default_alignment = std::align_val_t{__STDCPP_DEFAULT_NEW_ALIGNMENT__};
+
+void* operator new(const size_t size) { return bench_allocate_or_throw(size, default_alignment); }
+void* operator new[](const size_t size) { return bench_allocate_or_throw(size, default_alignment); }
+void* operator new(const size_t size, const std::align_val_t alignment) {
+    return bench_allocate_or_throw(size, alignment);
+}
+void* operator new[](const size_t size, const std::align_val_t alignment) {
+    return bench_allocate_or_throw(size, alignment);
+}
+void* operator new(const size_t size, const std::nothrow_t&) noexcept {
+    return bench_allocate(size, default_alignment);
+}
+void* operator new[](const size_t size, const std::nothrow_t&) noexcept {
+    return bench_allocate(size, default_alignment);
+}
+void* operator new(const size_t size, const std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return bench_allocate(size, alignment);
+}
+void* operator new[](const size_t size, const std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return bench_allocate(size, alignment);
+}
+
+void operator delete(void* memory) noexcept { bench_deallocate(memory, default_alignment); }
+void operator delete[](void* memory) noexcept { bench_deallocate(memory, default_alignment); }
+void operator delete(void* memory, size_t) noexcept { bench_deallocate(memory, default_alignment); }
+void operator delete[](void* memory, size_t) noexcept { bench_deallocate(memory, default_alignment); }
+void operator delete(void* memory, const std::align_val_t alignment) noexcept { bench_deallocate(memory, alignment); }
+void operator delete[](void* memory, const std::align_val_t alignment) noexcept {
+    bench_deallocate(memory, alignment);
+}
+void operator delete(void* memory, size_t, const std::align_val_t alignment) noexcept {
+    bench_deallocate(memory, alignment);
+}
+void operator delete[](void* memory, size_t, const std::align_val_t alignment) noexcept {
+    bench_deallocate(memory, alignment);
+}
+void operator delete(void* memory, const std::nothrow_t&) noexcept { bench_deallocate(memory, default_alignment); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { bench_deallocate(memory, default_alignment); }
+void operator delete(void* memory, const std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    bench_deallocate(memory, alignment);
+}
+void operator delete[](void* memory, const std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    bench_deallocate(memory, alignment);
+}
+
+
+// valid documents from tests
+const std::vector<std::string_view> test_corpus{
+    R"({})",
+    R"([])",
+    R"({"k1": "example"})",
+    R"({
+        "k1": "example",
+        "k2.0": 123,
+        "k2.1": -321,
+        "k3.0": 1.23,
+        "k3.1": -1.23,
+        "k4.0": 2.3e5,
+        "k4.1": 2.3E-5,
+        "k4.2": -4.6e-5,
+        "k4.3": -7.68E+5,
+        "k5.1": null,
+        "k5.2": true,
+        "k5.3": false
+    })",
+    R"([
+        "string",
+        123,
+        -321,
+        null
+    ])",
+    R"({"k1": "example", "k2": {"k2.2": "example2"}})",
+    R"([
+        {"k1": "example1"},
+        {"k2": "example2"}
+    ])",
+    R"([
+        {"k1": "example1"},
+        123
+    ])",
+    R"([[1, [2, 3]], {"k1": {"k1.1": [4]}, "k2": 5}, 6])",
+};
+
+template <typename F>
+double measure_seconds(F&& f) {
+    const auto start = std::chrono::steady_clock::now();
+    f();
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+struct BenchResult {
+    std::string name;
+    size_t bytes;
+    size_t documents;
+    double seconds;
+    size_t nodes; // nodes parsed, 0 when not known
+    size_t allocations; // during the measurement
+    size_t peak_rss_kb;
+    size_t lookups; // key lookups of find benchmarks, 0 for parsing
+};
+
+std::vector<BenchResult> bench_results{};
+
+void report(const std::string_view name, const size_t bytes, const size_t documents, const double seconds) {
+    std::cout << name << ": " << static_cast<double>(bytes) / seconds / 1e6 << " MB/s, "
+        << static_cast<double>(documents) / seconds << " docs/s" << std::endl;
+    bench_results.push_back({std::string(name), bytes, documents, seconds, 0, 0, 0, 0});
+}
+
+void report_parse(const std::string_view name, const size_t bytes, const size_t documents, const size_t nodes,
+                  const size_t allocations, const size_t peak_rss_kb, const double seconds) {
+    std::cout << name << ": " << static_cast<double>(bytes) / seconds / 1e6 << " MB/s, "
+        << static_cast<double>(nodes) / seconds / 1e6 << " M nodes/s, "
+        << seconds * 1e9 / static_cast<double>(nodes) << " ns/node, "
+        << static_cast<double>(allocations) / static_cast<double>(documents) << " allocations/doc, "
+        << peak_rss_kb / 1024 << " MB peak RSS" << std::endl;
+    bench_results.push_back({std::string(name), bytes, documents, seconds, nodes, allocations, peak_rss_kb, 0});
+}
+
+void report_lookups(const std::string_view name, const size_t lookups, const double seconds) {
+    std::cout << name << ": " << static_cast<double>(lookups) / seconds << " lookups/s" << std::endl;
+    bench_results.push_back({std::string(name), 0, 0, seconds, 0, 0, 0, lookups});
+}
+
+/**
+ * Start measuring peak RSS from the current RSS, where the kernel supports it (Linux)
+ */
+void reset_peak_rss() {
+    std::ofstream clear_refs("/proc/self/clear_refs");
+    clear_refs << "5";
+}
+
+size_t get_peak_rss_kb() {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.starts_with("VmHWM:")) {
+            return std::strtoull(line.c_str() + 6, nullptr, 10);
+        }
+    }
+#if defined(__unix__) || defined(__APPLE__)
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return static_cast<size_t>(usage.ru_maxrss) / 1024; // bytes
+#else
+    return static_cast<size_t>(usage.ru_maxrss);
+#endif
+#else
+    return 0;
+#endif
+}
+
+/**
+ * Results as json, one result per line so files of two versions can be compared with diff
+ */
+bool write_bench_results(const char* path) {
+    JsonWriter writer;
+    const auto simd_level = json_detect_simd_level();
+    writer.write_raw("{\"simd\": ");
+    writer.write_string(simd_level == JsonSimdLevel::avx2    ? "avx2"
+                        : simd_level == JsonSimdLevel::sse42 ? "sse4.2"
+                                                             : "scalar");
+    writer.write_raw(", \"results\": [\n");
+    for (size_t i = 0; i < bench_results.size(); ++i) {
+        const auto& result = bench_results[i];
+        std::ostringstream values;
+        if (result.documents > 0) {
+            values << ", \"bytes\": " << result.bytes << ", \"documents\": " << result.documents
+                << ", \"seconds\": " << result.seconds
+                << ", \"mb_per_s\": " << static_cast<double>(result.bytes) / result.seconds / 1e6
+                << ", \"docs_per_s\": " << static_cast<double>(result.documents) / result.seconds;
+        } else {
+            values << ", \"seconds\": " << result.seconds;
+        }
+        if (result.nodes > 0) {
+            values << ", \"nodes\": " << result.nodes
+                << ", \"nodes_per_s\": " << static_cast<double>(result.nodes) / result.seconds
+                << ", \"ns_per_node\": " << result.seconds * 1e9 / static_cast<double>(result.nodes)
+                << ", \"allocations_per_doc\": "
+                << static_cast<double>(result.allocations) / static_cast<double>(result.documents)
+                << ", \"peak_rss_kb\": " << result.peak_rss_kb;
+        }
+        if (result.lookups > 0) {
+            values << ", \"lookups\": " << result.lookups
+                << ", \"lookups_per_s\": " << static_cast<double>(result.lookups) / result.seconds;
+        }
+        writer.write_raw("  {\"name\": ");
+        writer.write_string(result.name);
+        writer.write_raw(values.view());
+        writer.write_raw(i + 1 < bench_results.size() ? "},\n" : "}\n");
+    }
+    writer.write_raw("]}\n");
+    std::ofstream file(path, std::ios::binary);
+    file << writer.view();
+    return static_cast<bool>(file);
+}
+
+void bench_test_corpus(const size_t rounds) {
+    size_t bytes = 0;
+    size_t documents = 0;
+    const auto seconds = measure_seconds(
+        [&] {
+            for (size_t i = 0; i < rounds; ++i) {
+                for (const auto json_data : test_corpus) {
+                    JsonTree tree(json_data);
+                    if (!tree.parse()) {
+                        std::cout << "Failed to parse test corpus!" << std::endl;
+                        std::exit(1);
+                    }
+                    bytes += json_data.size();
+                    ++documents;
+                }
+            }
+        });
+    report("test corpus", bytes, documents, seconds);
+}
+
+void bench_test_corpus_parser(const size_t rounds) {
+    size_t bytes = 0;
+    size_t documents = 0;
+    JsonParser parser;
+    JsonDocument document;
+    const auto seconds = measure_seconds(
+        [&] {
+            for (size_t i = 0; i < rounds; ++i) {
+                for (const auto json_data : test_corpus) {
+                    if (!parser.parse(json_data, document)) {
+                        std::cout << "Failed to parse test corpus!" << std::endl;
+                        std::exit(1);
+                    }
+                    bytes += json_data.size();
+                    ++documents;
+                }
+            }
+        });
+    report("test corpus, reused parser", bytes, documents, seconds);
+}
+
+void bench_test_corpus_cache(const size_t rounds) {
+    size_t bytes = 0;
+    size_t documents = 0;
+    JsonParseCache cache;
+    const auto seconds = measure_seconds(
+        [&] {
+            for (size_t i = 0; i < rounds; ++i) {
+                for (const auto json_data : test_corpus) {
+                    if (!cache.parse(json_data)->valid()) {
+                        std::cout << "Failed to parse test corpus!" << std::endl;
+                        std::exit(1);
+                    }
+                    bytes += json_data.size();
+                    ++documents;
+                }
+            }
+        });
+    report("test corpus, parse cache", bytes, documents, seconds);
+}
+
+void bench_corpus_parse(const BenchCorpus& corpus, const size_t rounds) {
+    size_t nodes = 0;
+    {
+        JsonTree tree(corpus.json_data);
+        if (!tree.parse()) {
+            std::cout << "Failed to parse " << corpus.name << " corpus!" << std::endl;
+            std::exit(1);
+        }
+        nodes = tree.get_nodes().size();
+    }
+    reset_peak_rss();
+    const auto allocations = allocations_count.load();
+    const auto seconds = measure_seconds(
+        [&] {
+            for (size_t i = 0; i < rounds; ++i) {
+                JsonTree tree(corpus.json_data);
+                if (!tree.parse()) {
+                    std::exit(1);
+                }
+            }
+        });
+    report_parse(corpus.name, corpus.json_data.size() * rounds, rounds, nodes * rounds,
+                 allocations_count.load() - allocations, get_peak_rss_kb(), seconds);
+}
+
+void bench_test_corpus_joined(const size_t copies, const size_t rounds, const JsonTreeParseOptions& options,
+                              const std::string_view name) {
+    std::string json_data{"["};
+    for (size_t i = 0; i < copies; ++i) {
+        for (const auto document : test_corpus) {
+            if (json_data.size() > 1) { json_data += ","; }
+            json_data += document;
+        }
+    }
+    json_data += "]";
+    const auto seconds = measure_seconds(
+        [&] {
+            for (size_t i = 0; i < rounds; ++i) {
+                JsonTree tree(json_data);
+                if (!tree.parse(options)) {
+                    std::cout << "Failed to parse joined test corpus!" << std::endl;
+                    std::exit(1);
+                }
+            }
+        });
+    report(name, json_data.size() * rounds, rounds, seconds);
+}
+
+void bench_parallel_joined(const size_t copies, const size_t rounds) {
+    std::string json_data{"["};
+    for (size_t i = 0; i < copies; ++i) {
+        for (const auto document : test_corpus) {
+            if (json_data.size() > 1) { json_data += ","; }
+            json_data += document;
+        }
+    }
+    json_data += "]";
+    JsonThreadPool pool;
+    JsonParallelParser parser(pool);
+    const auto seconds = measure_seconds(
+        [&] {
+            for (size_t i = 0; i < rounds; ++i) {
+                JsonTree tree(json_data);
+                if (!parser.parse(tree)) {
+                    std::cout << "Failed to parse joined test corpus in parallel!" << std::endl;
+                    std::exit(1);
+                }
+            }
+        });
+    report("joined test corpus, all threads", json_data.size() * rounds, rounds, seconds);
+}
+
+struct JsonValuesCounter {
+    size_t values{0};
+
+    void on_object_start() {}
+    void on_object_end() {}
+    void on_array_start() {}
+    void on_array_end() {}
+    void on_key(std::string_view) {}
+    void on_string(std::string_view) { ++values; }
+    void on_int(int) { ++values; }
+    void on_int64(int64_t) { ++values; }
+    void on_uint64(uint64_t) { ++values; }
+    void on_double(double) { ++values; }
+    void on_boolean(bool) { ++values; }
+    void on_null() { ++values; }
+};
+
+void bench_write_joined(const size_t copies, const size_t rounds, const JsonWriteOptions& options,
+                        const std::string_view name) {
+    std::string json_data{"["};
+    for (size_t i = 0; i < copies; ++i) {
+        for (const auto document : test_corpus) {
+            if (json_data.size() > 1) { json_data += ","; }
+            json_data += document;
+        }
+    }
+    json_data += "]";
+    JsonTree tree(json_data);
+    if (!tree.parse()) {
+        std::cout << "Failed to parse joined test corpus!" << std::endl;
+        std::exit(1);
+    }
+    size_t bytes = 0;
+    JsonWriter writer(options);
+    const auto seconds = measure_seconds(
+        [&] {
+            for (size_t i = 0; i < rounds; ++i) {
+                writer.clear();
+                writer.write(tree);
+                bytes += writer.get_size();
+            }
+        });
+    report(name, bytes, rounds, seconds);
+}
+
+void bench_edit_joined(const size_t copies, const size_t rounds) {
+    std::string json_data{"["};
+    for (size_t i = 0; i < copies; ++i) {
+        for (const auto document : test_corpus) {
+            if (json_data.size() > 1) { json_data += ","; }
+            json_data += document;
+        }
+    }
+    json_data += "]";
+    JsonTree tree(json_data);
+    if (!tree.parse()) {
+        std::cout << "Failed to parse joined test corpus!" << std::endl;
+        std::exit(1);
+    }
+    const JsonNode* last = nullptr;
+    for (const auto node : tree.get_root()->get_children()) { last = node; }
+    size_t bytes = 0;
+    JsonWriter writer;
+    const auto seconds = measure_seconds(
+        [&] {
+            for (size_t i = 0; i < rounds; ++i) {
+                JsonEditor editor(tree);
+                editor.set_value(last, JsonNode(static_cast<int>(i)));
+                writer.clear();
+                editor.write(writer);
+                bytes += writer.get_size();
+            }
+        });
+    report("edit one value of joined test corpus", bytes, rounds, seconds);
+}
+
+void bench_print_joined(const size_t copies, const size_t rounds) {
+    std::string json_data{"["};
+    for (size_t i = 0; i < copies; ++i) {
+        for (const auto document : test_corpus) {
+            if (json_data.size() > 1) { json_data += ","; }
+            json_data += document;
+        }
+    }
+    json_data += "]";
+    JsonTree tree(json_data);
+    if (!tree.parse()) {
+        std::cout << "Failed to parse joined test corpus!" << std::endl;
+        std::exit(1);
+    }
+    size_t bytes = 0;
+    const auto seconds = measure_seconds(
+        [&] {
+            for (size_t i = 0; i < rounds; ++i) {
+                std::ostringstream out;
+                print_json_tree(out, tree);
+                bytes += out.view().size();
+            }
+        });
+    report("print joined test corpus (debug format)", bytes, rounds, seconds);
+}
+
+void bench_image_joined(const size_t copies, const size_t rounds) {
+    std::string json_data{"["};
+    for (size_t i = 0; i < copies; ++i) {
+        for (const auto document : test_corpus) {
+            if (json_data.size() > 1) { json_data += ","; }
+            json_data += document;
+        }
+    }
+    json_data += "]";
+    const auto path = (std::filesystem::temp_directory_path() / "jsontree_bench_image.bin").string();
+    {
+        JsonTree tree(json_data);
+        if (!tree.parse() || !json_save_image(tree, path.c_str())) {
+            std::cout << "Failed to save image of joined test corpus!" << std::endl;
+            std::exit(1);
+        }
+    }
+    const auto seconds = measure_seconds(
+        [&] {
+            for (size_t i = 0; i < rounds; ++i) {
+                JsonImage image(path.c_str());
+                if (!image.valid()) {
+                    std::cout << "Failed to load image of joined test corpus!" << std::endl;
+                    std::exit(1);
+                }
+            }
+        });
+    std::filesystem::remove(path);
+    // bytes of json data, to compare with parsing
+    report("load image of joined test corpus", json_data.size() * rounds, rounds, seconds);
+}
+
+void bench_sax_joined(const size_t copies, const size_t rounds) {
+    std::string json_data{"["};
+    for (size_t i = 0; i < copies; ++i) {
+        for (const auto document : test_corpus) {
+            if (json_data.size() > 1) { json_data += ","; }
+            json_data += document;
+        }
+    }
+    json_data += "]";
+    const auto seconds = measure_seconds(
+        [&] {
+            for (size_t i = 0; i < rounds; ++i) {
+                JsonValuesCounter counter{};
+                JsonSaxParser parser(json_data, counter);
+                if (!parser.parse()) {
+                    std::cout << "Failed to parse joined test corpus with sax parser!" << std::endl;
+                    std::exit(1);
+                }
+            }
+        });
+    report("joined test corpus, sax", json_data.size() * rounds, rounds, seconds);
+}
+
+void bench_chunks_joined(const size_t copies, const size_t rounds, const size_t chunk_size) {
+    std::string json_data{"["};
+    for (size_t i = 0; i < copies; ++i) {
+        for (const auto document : test_corpus) {
+            if (json_data.size() > 1) { json_data += ","; }
+            json_data += document;
+        }
+    }
+    json_data += "]";
+    const std::string_view data{json_data};
+    const auto seconds = measure_seconds(
+        [&] {
+            for (size_t i = 0; i < rounds; ++i) {
+                JsonTree tree;
+                for (size_t position = 0; position < data.size(); position += chunk_size) {
+                    tree.feed(data.substr(position, chunk_size));
+                }
+                if (!tree.finish()) {
+                    std::cout << "Failed to parse joined test corpus in chunks!" << std::endl;
+                    std::exit(1);
+                }
+            }
+        });
+    const auto size =
+        chunk_size % 1024 == 0 ? std::to_string(chunk_size / 1024) + " KB" : std::to_string(chunk_size) + " B";
+    report("joined test corpus, " + size + " chunks", json_data.size() * rounds, rounds, seconds);
+}
+
+void bench_lines(const size_t copies, const size_t rounds, const size_t workers, const std::string_view name) {
+    std::string json_data;
+    for (size_t i = 0; i < copies; ++i) {
+        for (const auto document : test_corpus) {
+            for (const auto c : document) {
+                json_data += c == '\n' ? ' ' : c;
+            }
+            json_data += '\n';
+        }
+    }
+    JsonThreadPool pool(workers);
+    const auto seconds = measure_seconds(
+        [&] {
+            for (size_t i = 0; i < rounds; ++i) {
+                JsonLines lines(json_data);
+                if (!lines.parse(pool)) {
+                    std::cout << "Failed to parse json lines!" << std::endl;
+                    std::exit(1);
+                }
+            }
+        });
+    report(name, json_data.size() * rounds, copies * test_corpus.size() * rounds, seconds);
+}
+
+void bench_long_strings(const size_t strings, const size_t rounds) {
+    std::string json_data{"["};
+    for (size_t i = 0; i < strings; ++i) {
+        if (i > 0) { json_data += ","; }
+        json_data += "\"";
+        for (size_t j = 0; j < 1024; ++j) {
+            json_data += static_cast<char>('A' + (i + j) % 26);
+        }
+        json_data += i % 4 == 0 ? "\\\"\"" : "\"";
+    }
+    json_data += "]";
+    const auto seconds = measure_seconds(
+        [&] {
+            for (size_t i = 0; i < rounds; ++i) {
+                JsonTree tree(json_data);
+                if (!tree.parse()) {
+                    std::cout << "Failed to parse long strings!" << std::endl;
+                    std::exit(1);
+                }
+            }
+        });
+    report("long strings", json_data.size() * rounds, rounds, seconds);
+}
+
+void bench_structural_index(const size_t copies, const size_t rounds, const JsonSimdLevel level,
+                            const std::string_view name) {
+    std::string json_data{};
+    for (size_t i = 0; i < copies; ++i) {
+        for (const auto document : test_corpus) {
+            json_data += document;
+        }
+    }
+    std::vector<uint32_t> positions{};
+    const auto seconds = measure_seconds(
+        [&] {
+            for (size_t i = 0; i < rounds; ++i) {
+                json_build_structural_index(json_data, positions, level);
+            }
+        });
+    report(name, json_data.size() * rounds, rounds, seconds);
+}
+
+const JsonNode* find_key_linear(const JsonNode* object, const std::string_view key) {
+    for (auto const node : object->get_children()) {
+        if (node->get_key_name() == key) { return node; }
+    }
+    return nullptr;
+}
+
+template <typename Find>
+void bench_find_keys(const size_t keys, const size_t rounds, Find&& find, const std::string_view name) {
+    std::string json_data{"{"};
+    std::vector<std::string> names{};
+    for (size_t i = 0; i < keys; ++i) {
+        names.push_back("setting_" + std::to_string(i * 7919));
+        if (i > 0) { json_data += ","; }
+        json_data += "\"" + names.back() + "\": " + std::to_string(i);
+    }
+    json_data += "}";
+    JsonTree tree(json_data);
+    tree.parse();
+    size_t found = 0;
+    const auto seconds = measure_seconds(
+        [&] {
+            for (size_t i = 0; i < rounds; ++i) {
+                for (const auto& key : names) {
+                    found += find(tree.get_root(), key) != nullptr;
+                }
+            }
+        });
+    if (found != keys * rounds) {
+        std::cout << "Failed to find keys!" << std::endl;
+        std::exit(1);
+    }
+    report_lookups(name, found, seconds);
+}
+
+std::string make_request_document() {
+    std::string json_data{R"({"method": "POST", "route": "/api/v1/orders", "tenant": 42, "payload": [)"};
+    for (size_t i = 0; i < 50; ++i) {
+        if (i > 0) { json_data += ","; }
+        json_data += R"({"sku": "item-)" + std::to_string(i) + R"(", "count": 3, "price": 12.5, "tags": ["a", "b"]})";
+    }
+    json_data += R"(], "priority": true})";
+    return json_data;
+}
+
+void bench_read_fields_tree(const size_t rounds) {
+    const auto json_data = make_request_document();
+    size_t checksum = 0;
+    const auto seconds = measure_seconds(
+        [&] {
+            for (size_t i = 0; i < rounds; ++i) {
+                JsonTree tree(json_data);
+                tree.parse();
+                const auto root = tree.get_root();
+                checksum += root->find("route")->get_key_value_node()->get_value_string().size();
+                checksum += root->find("tenant")->get_key_value_node()->get_value_int();
+                checksum += root->find("priority")->get_key_value_node()->get_value_boolean();
+            }
+        });
+    if (checksum == 0) {
+        std::cout << "Failed to read fields!" << std::endl;
+        std::exit(1);
+    }
+    report("read 3 fields, tree", json_data.size() * rounds, rounds, seconds);
+}
+
+void bench_read_fields_cursor(const size_t rounds) {
+    const auto json_data = make_request_document();
+    size_t checksum = 0;
+    const auto seconds = measure_seconds(
+        [&] {
+            for (size_t i = 0; i < rounds; ++i) {
+                const JsonDocumentView document(json_data);
+                JsonNode node;
+                document.find("route").get_node(node);
+                checksum += node.get_value_string().size();
+                document.find("tenant").get_node(node);
+                checksum += node.get_value_int();
+                document.find("priority").get_node(node);
+                checksum += node.get_value_boolean();
+            }
+        });
+    if (checksum == 0) {
+        std::cout << "Failed to read fields!" << std::endl;
+        std::exit(1);
+    }
+    report("read 3 fields, cursor", json_data.size() * rounds, rounds, seconds);
+}
+
+
+struct BenchOrderItem {
+    std::string sku{};
+    int count{};
+    double price{};
+    std::vector<std::string> tags{};
+};
+
+template <>
+struct JsonFields<BenchOrderItem> {
+    static constexpr std::tuple fields{
+        json_field("sku", &BenchOrderItem::sku),
+        json_field("count", &BenchOrderItem::count),
+        json_field("price", &BenchOrderItem::price),
+        json_field("tags", &BenchOrderItem::tags),
+    };
+};
+
+struct BenchRequest {
+    std::string method{};
+    std::string route{};
+    int tenant{};
+    std::vector<BenchOrderItem> payload{};
+    bool priority{};
+};
+
+template <>
+struct JsonFields<BenchRequest> {
+    static constexpr std::tuple fields{
+        json_field("method", &BenchRequest::method),
+        json_field("route", &BenchRequest::route),
+        json_field("tenant", &BenchRequest::tenant),
+        json_field("payload", &BenchRequest::payload),
+        json_field("priority", &BenchRequest::priority),
+    };
+};
+
+void bench_read_request_bind(const size_t rounds) {
+    const auto json_data = make_request_document();
+    size_t checksum = 0;
+    BenchRequest request;
+    const auto seconds = measure_seconds(
+        [&] {
+            for (size_t i = 0; i < rounds; ++i) {
+                if (!json_bind(json_data, request).valid()) {
+                    std::cout << "Failed to bind request!" << std::endl;
+                    std::exit(1);
+                }
+                checksum += request.route.size() + request.tenant + request.payload.size();
+            }
+        });
+    if (checksum == 0) {
+        std::cout << "Failed to read fields!" << std::endl;
+        std::exit(1);
+    }
+    report("read whole request, bind", json_data.size() * rounds, rounds, seconds);
+}
+
+/**
+ * Usage: bench [--corpus] [--json results.json]
+ * --corpus runs only parsing of synthetic corpora, --json writes all results to a file
+ */
+int main(const int argc, char** argv) {
+    bool corpus_only = false;
+    const char* results_path = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view argument = argv[i];
+        if (argument == "--corpus") {
+            corpus_only = true;
+        } else if (argument == "--json" && i + 1 < argc) {
+            results_path = argv[++i];
+        } else {
+            std::cout << "Usage: " << argv[0] << " [--corpus] [--json results.json]" << std::endl;
+            return 1;
+        }
+    }
+    std::cout << "Running benchmarks..." << std::endl;
+    std::cout << "================" << std::endl;
+    for_each_bench_corpus(4 * 1024 * 1024, [](const BenchCorpus& corpus) { bench_corpus_parse(corpus, 10); });
+    if (corpus_only) {
+        std::cout << "================" << std::endl;
+        return results_path == nullptr || write_bench_results(results_path) ? 0 : 1;
+    }
+    bench_test_corpus(100000);
+    bench_test_corpus_parser(100000);
+    bench_test_corpus_cache(100000);
+    bench_test_corpus_joined(10000, 20, {}, "joined test corpus");
+    bench_test_corpus_joined(10000, 20, {.structural_index = true}, "joined test corpus, structural index");
+    bench_parallel_joined(10000, 20);
+    bench_image_joined(10000, 20);
+    bench_sax_joined(10000, 20);
+    bench_write_joined(10000, 20, {}, "write joined test corpus");
+    bench_write_joined(10000, 20, {.pretty = true}, "write joined test corpus, pretty");
+    bench_print_joined(10000, 20);
+    bench_edit_joined(10000, 20);
+    bench_chunks_joined(10000, 20, 64 * 1024);
+    bench_lines(10000, 20, 1, "json lines, 1 thread");
+    bench_lines(10000, 20, 0, "json lines, all threads");
+    bench_long_strings(10000, 20);
+    bench_structural_index(10000, 20, JsonSimdLevel::scalar, "structural index, scalar");
+    if (json_detect_simd_level() >= JsonSimdLevel::sse42) {
+        bench_structural_index(10000, 20, JsonSimdLevel::sse42, "structural index, sse4.2");
+    }
+    if (json_detect_simd_level() >= JsonSimdLevel::avx2) {
+        bench_structural_index(10000, 20, JsonSimdLevel::avx2, "structural index, avx2");
+    }
+    bench_read_fields_tree(20000);
+    bench_read_fields_cursor(20000);
+    bench_read_request_bind(20000);
+    bench_find_keys(500, 200, find_key_linear, "find among 500 keys, linear");
+    bench_find_keys(500, 200, [](auto object, auto key) { return object->find(key); }, "find among 500 keys");
+    std::cout << "================" << std::endl;
+    return results_path == nullptr || write_bench_results(results_path) ? 0 : 1;
+}
@@ -28,10 +28,23 @@
 #include <string>
 #include <string_view>
 #include <stack>
-#include <cctype>
-#include <functional>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <climits>
 #include <iomanip>
-#include <list>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "jsontree_chars.hpp"
+#include "jsontree_key_index.hpp"
+#include "jsontree_number.hpp"
+#include "jsontree_structural.hpp"
 
 
 enum class JsonTreeParseError {
@@ -55,160 +68,909 @@ enum class JsonTreeParseError {
     invalid_number_literal,
     trailing_comma,
     unexpected_end_of_data,
+    out_of_memory,
+    number_out_of_range,
+    invalid_escape_sequence,
+    stopped_by_handler,
+    value_type_mismatch,
+    too_many_items,
 };
 
-enum class JsonNodeType {
+enum class JsonNodeType : uint8_t {
     object,
     array,
     key,
     value,
 };
 
-enum class JsonValueType {
+enum class JsonValueType : uint8_t {
     v_string,
     v_int,
     v_double,
     v_boolean,
     v_null,
+    v_int64,
+    v_uint64,
+};
+
+/**
+ * String or key index stored after the node, at offset from it. Nodes with such values keep no pointers, so they
+ * can be used in read only memory (see JsonImage), but they are valid only in place and must not be copied.
+ */
+struct JsonRelativeValue {
+    uint64_t offset; // from the node
+    uint64_t size; // length of string, slots of key index
 };
 
 union JsonValue {
     int v_int{};
+    int64_t v_int64;
+    uint64_t v_uint64;
     double v_double;
     bool v_boolean;
     std::string_view v_string;
+    JsonKeyIndexRef v_key_index; // object nodes
+    JsonRelativeValue v_relative; // strings and big objects of images
 };
 
+class JsonNode;
+
+template <typename Node>
+class JsonBasicNodeChildren;
+
+using JsonNodeChildren = JsonBasicNodeChildren<JsonNode>;
+
+/**
+ * Node of the tree.
+ *
+ * Nodes are stored in one contiguous array in document order (tape), so children of a node follow the node
+ * directly and the next sibling is placed right after the whole subtree. Node keeps only the count of its
+ * children and the size of its subtree, there are no pointers into the tape, so it can be moved as a whole.
+ */
 class JsonNode {
+    static constexpr uint8_t raw_number_flag = 0x01; // value keeps number text, decoded on first access
+    static constexpr uint8_t escapes_flag = 0x02; // string in json data contains escape sequences
+    static constexpr uint8_t relative_flag = 0x04; // value is JsonRelativeValue
+
     JsonNodeType type;
     JsonValueType value_type{JsonValueType::v_null};
-    JsonValue value{};
-    std::list<JsonNode*> children{};
+    mutable uint8_t flags{0};
+    uint32_t children_count{0};
+    uint32_t subtree_size{1}; // offset to the next sibling
+    mutable JsonValue value{};
+
+    constexpr void set_key_type() { type = JsonNodeType::key; }
 
-    void set_key_type() { type = JsonNodeType::key; }
+    constexpr void decode() const {
+        if (flags & raw_number_flag) [[unlikely]] {
+            decode_number();
+        }
+    }
+
+    void decode_number() const;
+    const JsonKeyIndex* build_key_index() const;
 
 public:
-    friend class JsonTree;
+    friend class JsonTreeBuilder;
+    friend class JsonDocument;
+    friend class JsonCursor;
+    friend class JsonLines;
+    friend class JsonParallelParser;
+    friend class JsonImage;
 
-    explicit JsonNode(const JsonNodeType type_): type(type_) {}
+    constexpr explicit JsonNode(const JsonNodeType type_): type(type_), value{.v_key_index = {}} {}
 
-    explicit JsonNode
+    constexpr explicit JsonNode
     (const int value): type(JsonNodeType::value), value_type(JsonValueType::v_int), value{.v_int = value} {}
 
-    explicit JsonNode
+    constexpr explicit JsonNode
+    (const int64_t value): type(JsonNodeType::value), value_type(JsonValueType::v_int64), value{.v_int64 = value} {}
+
+    constexpr explicit JsonNode
+    (const uint64_t value)
+        : type(JsonNodeType::value), value_type(JsonValueType::v_uint64), value{.v_uint64 = value} {}
+
+    constexpr explicit JsonNode
     (const double value): type(JsonNodeType::value), value_type(JsonValueType::v_double), value{.v_double = value} {}
 
-    explicit JsonNode
+    constexpr explicit JsonNode
     (const bool value): type(JsonNodeType::value), value_type(JsonValueType::v_boolean), value{.v_boolean = value} {}
 
-    explicit JsonNode
+    constexpr explicit JsonNode
     (const std::string_view value)
         : type(JsonNodeType::value), value_type(JsonValueType::v_string), value{.v_string = value} {}
 
-    explicit JsonNode(): type(JsonNodeType::value) {}
-
-    [[nodiscard]] auto is_array() const { return type == JsonNodeType::array; }
-    [[nodiscard]] auto is_object() const { return type == JsonNodeType::object; }
-    [[nodiscard]] auto is_container() const { return type == JsonNodeType::object || type == JsonNodeType::array; }
-    [[nodiscard]] auto is_key() const { return type == JsonNodeType::key; }
-    [[nodiscard]] auto is_value() const { return type == JsonNodeType::value; }
-    [[nodiscard]] auto is_string() const { return value_type == JsonValueType::v_string; }
-    [[nodiscard]] auto is_int() const { return value_type == JsonValueType::v_int; }
-    [[nodiscard]] auto is_double() const { return value_type == JsonValueType::v_double; }
-    [[nodiscard]] auto is_boolean() const { return value_type == JsonValueType::v_boolean; }
-    [[nodiscard]] auto is_null() const { return value_type == JsonValueType::v_null; }
-    [[nodiscard]] auto get_type() const { return type; }
-    [[nodiscard]] auto get_value_type() const { return value_type; }
-    [[nodiscard]] auto get_value() const { return value; }
-    [[nodiscard]] auto get_value_string() const { return value.v_string; }
-    [[nodiscard]] auto get_value_int() const { return value.v_int; }
-    [[nodiscard]] auto get_value_double() const { return value.v_double; }
-    [[nodiscard]] auto get_value_boolean() const { return value.v_boolean; }
-    void add_child(JsonNode* node) { children.push_back(node); }
-    [[nodiscard]] auto& get_children() const { return children; }
-    [[nodiscard]] auto get_key_name() const { return get_value_string(); }
-    [[nodiscard]] auto get_key_value_node() const { return children.front(); }
+    constexpr explicit JsonNode(): type(JsonNodeType::value) {}
+
+    /**
+     * Number which is not decoded yet, value_type is v_int or v_double, raw must be well formed.
+     * Decoding caches the value in the node, so such node must not be read from many threads at once.
+     */
+    constexpr explicit JsonNode
+    (const JsonValueType number_type, const std::string_view raw)
+        : type(JsonNodeType::value), value_type(number_type), flags(raw_number_flag), value{.v_string = raw} {}
+
+    [[nodiscard]] constexpr auto is_array() const { return type == JsonNodeType::array; }
+    [[nodiscard]] constexpr auto is_object() const { return type == JsonNodeType::object; }
+    [[nodiscard]] constexpr auto is_container() const {
+        return type == JsonNodeType::object || type == JsonNodeType::array;
+    }
+
+    [[nodiscard]] constexpr auto is_key() const { return type == JsonNodeType::key; }
+    [[nodiscard]] constexpr auto is_value() const { return type == JsonNodeType::value; }
+    [[nodiscard]] constexpr auto is_string() const { return value_type == JsonValueType::v_string; }
+    [[nodiscard]] constexpr auto is_int() const { return value_type == JsonValueType::v_int; }
+    [[nodiscard]] constexpr auto is_int64() const { return value_type == JsonValueType::v_int64; }
+    [[nodiscard]] constexpr auto is_uint64() const { return value_type == JsonValueType::v_uint64; }
+    [[nodiscard]] constexpr auto is_integer() const { return is_int() || is_int64() || is_uint64(); }
+    [[nodiscard]] constexpr auto is_double() const { return value_type == JsonValueType::v_double; }
+    [[nodiscard]] constexpr auto is_boolean() const { return value_type == JsonValueType::v_boolean; }
+    [[nodiscard]] constexpr auto is_null() const { return value_type == JsonValueType::v_null; }
+    [[nodiscard]] constexpr auto get_type() const { return type; }
+    [[nodiscard]] constexpr auto get_value_type() const { return value_type; }
+    [[nodiscard]] constexpr JsonValue get_value() const {
+        decode();
+        if (flags & relative_flag) [[unlikely]] {
+            return is_string() ? JsonValue{.v_string = get_value_string()} : JsonValue{.v_key_index = {}};
+        }
+        return value;
+    }
+
+    [[nodiscard]] constexpr std::string_view get_value_string() const {
+        if (flags & relative_flag) [[unlikely]] {
+            return {reinterpret_cast<const char*>(this) + value.v_relative.offset, value.v_relative.size};
+        }
+        return value.v_string;
+    }
+
+    [[nodiscard]] constexpr auto get_value_int() const {
+        decode();
+        return value.v_int;
+    }
+
+    // integers which fit in int are stored as v_int, wider ones as v_int64, above INT64_MAX as v_uint64
+    [[nodiscard]] constexpr int64_t get_value_int64() const { return is_int() ? get_value_int() : value.v_int64; }
+    [[nodiscard]] constexpr uint64_t get_value_uint64() const {
+        return is_uint64() ? value.v_uint64 : get_value_int64();
+    }
+
+    [[nodiscard]] constexpr auto get_value_double() const {
+        decode();
+        return value.v_double;
+    }
+
+    [[nodiscard]] constexpr auto has_escapes() const { return (flags & escapes_flag) != 0; }
+    [[nodiscard]] constexpr auto has_raw_number() const { return (flags & raw_number_flag) != 0; }
+    [[nodiscard]] constexpr auto get_raw_number() const {
+        return has_raw_number() ? value.v_string : std::string_view{};
+    }
+
+    [[nodiscard]] constexpr auto get_value_boolean() const { return value.v_boolean; }
+    [[nodiscard]] constexpr auto get_children_count() const { return children_count; }
+    [[nodiscard]] constexpr auto get_subtree_size() const { return subtree_size; }
+    [[nodiscard]] JsonNodeChildren get_children() const;
+    [[nodiscard]] constexpr auto get_key_name() const { return get_value_string(); }
+    [[nodiscard]] constexpr const JsonNode* get_key_value_node() const { return this + 1; }
+    [[nodiscard]] constexpr const JsonNode* get_next_sibling() const { return this + subtree_size; }
+
+    /**
+     * Key node with given name in object node, nullptr if there is no such key or node is not object.
+     * Big objects build hash index on the first call, objects which are never searched do not pay for it.
+     */
+    [[nodiscard]] const JsonNode* find(std::string_view key) const { return find(key, json_key_hash(key)); }
+    [[nodiscard]] const JsonNode* find(std::string_view key, uint32_t key_hash) const;
 
 };
 
+static_assert(std::is_trivially_copyable_v<JsonNode> && std::is_trivially_destructible_v<JsonNode>);
 
-class JsonTree {
-    const std::string_view json_data;
-    std::stack<JsonNode*, std::list<JsonNode*>> parents{};
-    std::list<JsonNode*> nodes{};
+inline void JsonNode::decode_number() const {
+    const auto raw = value.v_string;
+    if (value_type == JsonValueType::v_int) {
+        int number{};
+        std::from_chars(raw.data(), raw.data() + raw.size(), number);
+        value.v_int = number;
+    } else {
+        double number{};
+        std::from_chars(raw.data(), raw.data() + raw.size(), number);
+        value.v_double = number;
+    }
+    flags &= ~raw_number_flag;
+}
+
+inline const JsonKeyIndex* JsonNode::build_key_index() const {
+    auto& pool = *value.v_key_index.pool;
+    const std::lock_guard lock(pool.mutex);
+    std::atomic_ref index_ref(value.v_key_index.index);
+    if (const auto index = index_ref.load(std::memory_order_relaxed)) {
+        return index;
+    }
+    auto& index = pool.add(children_count);
+    auto key = this + 1;
+    for (uint32_t i = 0; i < children_count; ++i, key = key->get_next_sibling()) {
+        index.insert(json_key_hash(key->get_key_name()), static_cast<uint32_t>(key - this));
+    }
+    index_ref.store(&index, std::memory_order_release);
+    return &index;
+}
+
+
+/**
+ * Lightweight range over direct children of a node. Node is JsonNode, or a node type with the same tape layout
+ * and accessors (see JsonStaticNode).
+ */
+template <typename Node>
+class JsonBasicNodeChildren {
+    const Node* first{nullptr};
+    uint32_t count{0};
+
+public:
+    class iterator {
+        const Node* node{nullptr};
+        uint32_t remaining{0};
+
+        friend class JsonBasicNodeChildren;
+
+        constexpr iterator(const Node* node_, const uint32_t remaining_) : node(node_), remaining(remaining_) {}
+
+    public:
+        using value_type = const Node*;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+        constexpr const Node* operator*() const { return node; }
+
+        constexpr iterator& operator++() {
+            node = node->get_next_sibling();
+            --remaining;
+            return *this;
+        }
+
+        constexpr iterator operator++(int) {
+            auto it = *this;
+            ++*this;
+            return it;
+        }
+
+        constexpr bool operator==(const iterator& other) const { return remaining == other.remaining; }
+    };
+
+    JsonBasicNodeChildren() = default;
+    constexpr JsonBasicNodeChildren(const Node* first_, const uint32_t count_) : first(first_), count(count_) {}
+
+    [[nodiscard]] constexpr iterator begin() const { return {first, count}; }
+    [[nodiscard]] constexpr iterator end() const { return {}; }
+    [[nodiscard]] constexpr auto size() const { return static_cast<size_t>(count); }
+    [[nodiscard]] constexpr auto empty() const { return count == 0; }
+    [[nodiscard]] constexpr const Node* front() const { return first; }
+
+    [[nodiscard]] constexpr const Node* back() const {
+        auto node = first;
+        for (uint32_t i = 1; i < count; ++i) {
+            node = node->get_next_sibling();
+        }
+        return node;
+    }
+};
+
+inline JsonNodeChildren JsonNode::get_children() const { return {this + 1, children_count}; }
+
+inline const JsonNode* JsonNode::find(const std::string_view key, const uint32_t key_hash) const {
+    if (!is_object()) {
+        return nullptr;
+    }
+    const auto match = [&](const uint32_t offset_) { return this[offset_].get_key_name() == key; };
+    if (flags & relative_flag) {
+        // key index stored in image
+        const auto slots = reinterpret_cast<const JsonKeyIndex::Slot*>(reinterpret_cast<const char*>(this) +
+                                                                        value.v_relative.offset);
+        const auto offset = JsonKeyIndex::find(slots, value.v_relative.size - 1, key_hash, match);
+        return offset != 0 ? this + offset : nullptr;
+    }
+    if (value.v_key_index.pool != nullptr) {
+        auto index = std::atomic_ref(value.v_key_index.index).load(std::memory_order_acquire);
+        if (index == nullptr) {
+            index = build_key_index();
+        }
+        const auto offset = index->find(key_hash, match);
+        return offset != 0 ? this + offset : nullptr;
+    }
+    for (auto const node : get_children()) {
+        if (node->get_key_name() == key) {
+            return node;
+        }
+    }
+    return nullptr;
+}
+
+
+/**
+ * Bump allocator for JsonNode objects.
+ *
+ * Nodes are placed one after another in a single contiguous array, which keeps tree traversal cache friendly and
+ * costs only a few allocations per tree. The arena can be placed over a caller supplied buffer (e.g. a static
+ * array), then nodes are taken from that buffer and the heap is used only when heap fallback is enabled. When no
+ * space is left, create() returns nullptr and the parser reports out_of_memory.
+ *
+ * Growing the array moves the nodes, so pointers returned by create() are valid only until the next create().
+ * One arena backs one JsonTree at a time, the tree clears it when it is destroyed. Clearing keeps the memory,
+ * so an arena reused for many trees stops allocating once it is big enough.
+ */
+class JsonNodeArena {
+    JsonNode* nodes{nullptr};
+    size_t capacity{0};
+    size_t nodes_count{0};
+    size_t initial_capacity;
+    bool owned{false};
+    bool heap_enabled{true};
+
+    bool grow();
+
+public:
+    static constexpr size_t default_capacity = 1024;
+
+    class iterator {
+        const JsonNode* node{nullptr};
+
+        friend class JsonNodeArena;
+
+        explicit iterator(const JsonNode* node_) : node(node_) {}
+
+    public:
+        using value_type = const JsonNode*;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+        const JsonNode* operator*() const { return node; }
+
+        iterator& operator++() {
+            ++node;
+            return *this;
+        }
+
+        iterator operator++(int) {
+            auto it = *this;
+            ++*this;
+            return it;
+        }
+
+        bool operator==(const iterator& other) const = default;
+    };
+
+    explicit JsonNodeArena(const size_t initial_capacity_ = default_capacity)
+        : initial_capacity(initial_capacity_ > 0 ? initial_capacity_ : 1) {}
+
+    /**
+     * Use caller supplied buffer for nodes. Buffer must outlive the arena.
+     */
+    JsonNodeArena(void* buffer, size_t buffer_size, const bool heap_fallback = false,
+                  const size_t initial_capacity_ = default_capacity)
+        : initial_capacity(initial_capacity_ > 0 ? initial_capacity_ : 1), heap_enabled(heap_fallback) {
+        if (std::align(alignof(JsonNode), sizeof(JsonNode), buffer, buffer_size) != nullptr) {
+            nodes = static_cast<JsonNode*>(buffer);
+            capacity = buffer_size / sizeof(JsonNode);
+        }
+    }
+
+    JsonNodeArena(const JsonNodeArena& other) = delete;
+
+    /**
+     * Moved arena takes nodes of other arena, other arena is left empty without memory
+     */
+    JsonNodeArena(JsonNodeArena&& other) noexcept
+        : nodes(other.nodes), capacity(other.capacity), nodes_count(other.nodes_count),
+          initial_capacity(other.initial_capacity), owned(other.owned), heap_enabled(other.heap_enabled) {
+        other.nodes = nullptr;
+        other.capacity = 0;
+        other.nodes_count = 0;
+        other.owned = false;
+    }
+
+    JsonNodeArena& operator=(JsonNodeArena&& other) noexcept {
+        if (this != &other) {
+            release();
+            nodes = std::exchange(other.nodes, nullptr);
+            capacity = std::exchange(other.capacity, 0);
+            nodes_count = std::exchange(other.nodes_count, 0);
+            initial_capacity = other.initial_capacity;
+            owned = std::exchange(other.owned, false);
+            heap_enabled = other.heap_enabled;
+        }
+        return *this;
+    }
+
+    ~JsonNodeArena() { release(); }
+
+    /**
+     * Size of caller buffer which is able to hold given number of nodes
+     */
+    static constexpr size_t buffer_size_for(const size_t nodes) { return alignof(JsonNode) + nodes * sizeof(JsonNode); }
+
+    template <typename... Args>
+    JsonNode* create(Args&&... args) {
+        if (nodes_count == capacity && !grow()) {
+            return nullptr;
+        }
+        return ::new(nodes + nodes_count++) JsonNode(std::forward<Args>(args)...);
+    }
+
+    /**
+     * Make room for given number of nodes, returns false if not possible
+     */
+    bool reserve(size_t nodes_capacity);
+
+    /**
+     * Add given number of nodes at the end without constructing them, caller fills them (e.g. copies nodes of
+     * another tape). Returns nullptr if not possible.
+     */
+    JsonNode* allocate(size_t count);
+
+    void clear() { nodes_count = 0; }
+
+    /**
+     * Clear arena and free heap memory
+     */
+    void release();
+
+    [[nodiscard]] auto size() const { return nodes_count; }
+    [[nodiscard]] auto empty() const { return nodes_count == 0; }
+    [[nodiscard]] auto get_capacity() const { return capacity; }
+    [[nodiscard]] auto heap_fallback() const { return heap_enabled; }
+    [[nodiscard]] iterator begin() const { return iterator{nodes}; }
+    [[nodiscard]] iterator end() const { return iterator{nodes + nodes_count}; }
+    [[nodiscard]] const JsonNode* front() const { return nodes; }
+    [[nodiscard]] JsonNode& operator[](const size_t index) { return nodes[index]; }
+    [[nodiscard]] const JsonNode& operator[](const size_t index) const { return nodes[index]; }
+};
+
+inline bool JsonNodeArena::reserve(const size_t nodes_capacity) {
+    if (nodes_capacity <= capacity) {
+        return true;
+    }
+    if (!heap_enabled) {
+        return false;
+    }
+    const auto memory = static_cast<JsonNode*>(::operator new(nodes_capacity * sizeof(JsonNode), std::nothrow));
+    if (memory == nullptr) {
+        return false;
+    }
+    if (nodes_count > 0) {
+        std::memcpy(static_cast<void*>(memory), nodes, nodes_count * sizeof(JsonNode));
+    }
+    if (owned) {
+        ::operator delete(nodes);
+    }
+    nodes = memory;
+    capacity = nodes_capacity;
+    owned = true;
+    return true;
+}
+
+inline JsonNode* JsonNodeArena::allocate(const size_t count) {
+    if (nodes_count + count > capacity && !reserve(std::max(nodes_count + count, capacity * 2))) {
+        return nullptr;
+    }
+    const auto first = nodes + nodes_count;
+    nodes_count += count;
+    return first;
+}
+
+inline bool JsonNodeArena::grow() { return reserve(capacity > 0 ? capacity * 2 : initial_capacity); }
+
+inline void JsonNodeArena::release() {
+    if (owned) {
+        ::operator delete(nodes);
+        nodes = nullptr;
+        capacity = 0;
+        owned = false;
+    }
+    nodes_count = 0;
+}
+
+struct JsonTreeParseOptions {
+    bool structural_index{false}; // build index of structural positions (SIMD when available) before parsing
+    bool lazy_numbers{false}; // keep number text in nodes, convert on first get_value_int()/get_value_double()
+    bool decode_escapes{true}; // decode strings with escape sequences, otherwise keep raw text
+};
+
+
+/**
+ * Write UTF-8 encoded code point to out, which must have room for 4 bytes. Returns number of bytes written.
+ */
+constexpr size_t json_encode_utf8(const uint32_t code_point, char* out) {
+    if (code_point < 0x80) {
+        out[0] = static_cast<char>(code_point);
+        return 1;
+    }
+    if (code_point < 0x800) {
+        out[0] = static_cast<char>(0xC0 | code_point >> 6);
+        out[1] = static_cast<char>(0x80 | (code_point & 0x3F));
+        return 2;
+    }
+    if (code_point < 0x10000) {
+        out[0] = static_cast<char>(0xE0 | code_point >> 12);
+        out[1] = static_cast<char>(0x80 | (code_point >> 6 & 0x3F));
+        out[2] = static_cast<char>(0x80 | (code_point & 0x3F));
+        return 3;
+    }
+    out[0] = static_cast<char>(0xF0 | code_point >> 18);
+    out[1] = static_cast<char>(0x80 | (code_point >> 12 & 0x3F));
+    out[2] = static_cast<char>(0x80 | (code_point >> 6 & 0x3F));
+    out[3] = static_cast<char>(0x80 | (code_point & 0x3F));
+    return 4;
+}
+
+/**
+ * Read 4 hex digits of unicode escape sequence at index, -1 when they are not valid
+ */
+constexpr int32_t json_decode_hex4(const std::string_view raw, const size_t index) {
+    if (index + 4 > raw.size()) {
+        return -1;
+    }
+    int32_t value = 0;
+    for (size_t i = index; i < index + 4; ++i) {
+        const auto digit = json_hex_digit_value(raw[i]);
+        if (digit < 0) {
+            return -1;
+        }
+        value = value << 4 | digit;
+    }
+    return value;
+}
+
+/**
+ * Decode content of string (without quotes), decoded pieces are passed to append(const char* data, size_t size).
+ * Surrogate pairs are joined into one code point. Returns position of the first invalid escape sequence, or
+ * raw.size() when all of them are valid.
+ */
+template <typename Append>
+constexpr size_t json_decode_string_to(const std::string_view raw, Append&& append) {
+    size_t index = 0;
+    char utf8[4]{};
+    while (index < raw.size()) {
+        const auto escape = json_find_quote_or_backslash(raw, index);
+        if (escape > index) {
+            append(raw.data() + index, escape - index);
+        }
+        if (escape == raw.size()) {
+            break;
+        }
+        if (escape + 1 == raw.size()) {
+            return escape;
+        }
+        index = escape + 2;
+        switch (raw[escape + 1]) {
+        case '"':
+        case '\\':
+        case '/':
+            append(raw.data() + escape + 1, 1);
+            break;
+        case 'b':
+            append("\b", 1);
+            break;
+        case 'f':
+            append("\f", 1);
+            break;
+        case 'n':
+            append("\n", 1);
+            break;
+        case 'r':
+            append("\r", 1);
+            break;
+        case 't':
+            append("\t", 1);
+            break;
+        case 'u': {
+            const auto code = json_decode_hex4(raw, index);
+            if (code < 0 || (code >= 0xDC00 && code <= 0xDFFF)) {
+                return escape;
+            }
+            index += 4;
+            if (code < 0xD800 || code > 0xDBFF) {
+                append(utf8, json_encode_utf8(static_cast<uint32_t>(code), utf8));
+                break;
+            }
+            // high surrogate must be followed by low one
+            if (index + 2 > raw.size() || raw[index] != '\\' || raw[index + 1] != 'u') {
+                return escape;
+            }
+            const auto low = json_decode_hex4(raw, index + 2);
+            if (low < 0xDC00 || low > 0xDFFF) {
+                return escape;
+            }
+            index += 6;
+            const auto code_point = 0x10000 + ((static_cast<uint32_t>(code) - 0xD800) << 10) + (low - 0xDC00);
+            append(utf8, json_encode_utf8(code_point, utf8));
+            break;
+        }
+        default:
+            return escape;
+        }
+    }
+    return raw.size();
+}
+
+
+/**
+ * Append decoded content of string (without quotes) to out, see json_decode_string_to()
+ */
+constexpr size_t json_decode_string(const std::string_view raw, std::vector<char>& out) {
+    return json_decode_string_to(raw, [&out](const char* data, const size_t size) {
+        out.insert(out.end(), data, data + size);
+    });
+}
+
+/**
+ * Compare content of string with escape sequences (without quotes) with decoded text, without allocation
+ */
+inline bool json_decoded_string_equals(const std::string_view raw, const std::string_view text) {
+    size_t matched = 0;
+    bool equal = true;
+    const auto invalid = json_decode_string_to(raw, [&](const char* data, const size_t size) {
+        equal = equal && matched + size <= text.size() && std::memcmp(text.data() + matched, data, size) == 0;
+        matched += size;
+    });
+    return equal && invalid == raw.size() && matched == text.size();
+}
+
+/**
+ * Scan number literal at index. Index is moved past the literal, or stays at the invalid character.
+ * is_double is set when literal has fraction or exponent. Number and literal functions are shared by JsonTree
+ * and JsonCursor, so both report the same errors.
+ */
+constexpr JsonTreeParseError json_scan_number(const std::string_view data, size_t& index, bool& is_double) {
+    bool contains_dot = false;
+    bool contains_e = false;
+    const size_t start = index;
+    while (index < data.size() && json_is_number_char(data[index])) {
+        if (data[index] == '.') {
+            if (contains_dot) {
+                return JsonTreeParseError::invalid_number_literal;
+            }
+            contains_dot = true;
+        }
+        if (data[index] == 'e' || data[index] == 'E') {
+            if (contains_e) {
+                return JsonTreeParseError::invalid_number_literal;
+            }
+            contains_e = true;
+        }
+        if (data[index] == '-' && start != index && data[index - 1] != 'e' && data[index - 1] != 'E') {
+            return JsonTreeParseError::invalid_number_literal;
+        }
+        if (data[index] == '+' && data[index - 1] != 'e' && data[index - 1] != 'E') {
+            return JsonTreeParseError::invalid_number_literal;
+        }
+        index++;
+    }
+    is_double = contains_dot || contains_e;
+    return JsonTreeParseError::no_error;
+}
+
+/**
+ * Numbers are converted in place with std::from_chars: no allocation, no locale, no exceptions. In constant
+ * expressions its replicas from jsontree_number.hpp give the same results. Converted number is passed to visitor.
+ */
+template <typename Visitor>
+constexpr JsonTreeParseError json_visit_number_double(const std::string_view value, Visitor&& visitor) {
+    const auto value_end = value.data() + value.size();
+    double number{};
+    const auto converted = json_from_chars(value.data(), value_end, number);
+    if (converted.ec == std::errc::result_out_of_range) {
+        return JsonTreeParseError::number_out_of_range;
+    }
+    if (converted.ec != std::errc{} || converted.ptr != value_end) {
+        return JsonTreeParseError::invalid_number_literal;
+    }
+    visitor(number);
+    return JsonTreeParseError::no_error;
+}
+
+/**
+ * Integers which fit in int are passed as int, wider ones as int64_t, above INT64_MAX as uint64_t
+ */
+template <typename Visitor>
+constexpr JsonTreeParseError json_visit_number_integer(const std::string_view value, Visitor&& visitor) {
+    const auto value_end = value.data() + value.size();
+    int64_t number{};
+    auto converted = json_from_chars(value.data(), value_end, number);
+    if (converted.ec == std::errc::result_out_of_range && value.front() != '-') {
+        uint64_t unsigned_number{};
+        converted = json_from_chars(value.data(), value_end, unsigned_number);
+        if (converted.ec == std::errc{} && converted.ptr == value_end) {
+            visitor(unsigned_number);
+            return JsonTreeParseError::no_error;
+        }
+    }
+    if (converted.ec == std::errc::result_out_of_range) {
+        return JsonTreeParseError::number_out_of_range;
+    }
+    if (converted.ec != std::errc{} || converted.ptr != value_end) {
+        return JsonTreeParseError::invalid_number_literal;
+    }
+    if (number >= INT_MIN && number <= INT_MAX) {
+        visitor(static_cast<int>(number));
+    } else {
+        visitor(number);
+    }
+    return JsonTreeParseError::no_error;
+}
+
+template <typename Visitor>
+constexpr JsonTreeParseError json_visit_number(const std::string_view value, const bool is_double, Visitor&& visitor) {
+    return is_double ? json_visit_number_double(value, visitor) : json_visit_number_integer(value, visitor);
+}
+
+/**
+ * Convert scanned number literal to value node. With lazy, literals which can be decoded later keep their text.
+ */
+constexpr JsonTreeParseError json_convert_number(const std::string_view value, const bool is_double, const bool lazy,
+                                                 JsonNode& node) {
+    if (lazy && json_is_number_lazy_decodable(value)) {
+        node = JsonNode(is_double ? JsonValueType::v_double : JsonValueType::v_int, value);
+        return JsonTreeParseError::no_error;
+    }
+    return json_visit_number(value, is_double, [&](const auto number) { node = JsonNode(number); });
+}
+
+constexpr JsonTreeParseError json_convert_literal(const std::string_view literal, JsonNode& node) {
+    if (literal == "true" || literal == "false") {
+        node = JsonNode(literal == "true");
+        return JsonTreeParseError::no_error;
+    }
+    if (literal == "null") {
+        node = JsonNode();
+        return JsonTreeParseError::no_error;
+    }
+    return JsonTreeParseError::unexpected_literal;
+}
+
+
+/**
+ * Event parser, checks JSON grammar and calls handler for every element instead of building nodes.
+ *
+ * Handler is template parameter, so event calls are inlined. Handler must provide:
+ *     on_object_start(), on_object_end(), on_array_start(), on_array_end(),
+ *     on_key(std::string_view), on_string(std::string_view), on_int(int), on_int64(int64_t), on_uint64(uint64_t),
+ *     on_double(double), on_boolean(bool), on_null()
+ * Events may return void or bool, false stops parsing with stopped_by_handler error. With lazy_numbers option
+ * handler may also provide on_raw_number(JsonValueType, std::string_view), which gets text of numbers which
+ * can be decoded later without errors.
+ *
+ * Strings are views of json data, strings with escape sequences are decoded into a buffer which is reused for
+ * the next string, so they are valid only during the event. Parser keeps only the stack of open containers,
+ * so memory does not depend on the size of json data. Events of a document which turns out to be malformed are
+ * delivered up to the error.
+ *
+ * Handler may take has_escapes flag as the second argument of on_key() and on_string().
+ *
+ * Data can be passed at once to parse() or in chunks to feed() and finish(). Chunks are parsed as they come,
+ * only a token which is cut by the end of chunk is copied and completed with the next chunk. Strings are then
+ * views of the chunk or of that copy and are valid only during the event. Events, errors and indexes are the same
+ * as for the whole data passed to parse(), except that structural_index option is not used for chunks.
+ *
+ * Parser runs in constant expressions too, json_static_tree is built by it. Structural index is not used there.
+ */
+template <typename Handler>
+class JsonSaxParser {
+    struct Parent {
+        JsonNodeType type; // object, array or key
+        uint32_t children_count;
+    };
+
+    enum class Element : uint8_t {
+        object,
+        array,
+        string,
+        scalar,
+    };
+
+    std::string_view json_data; // whole data or current chunk
+    Handler& handler;
+    std::vector<Parent> parents{};
+    std::vector<char> strings{}; // decoded current string
+    std::vector<uint32_t> positions{}; // structural index
     JsonTreeParseError error_code{JsonTreeParseError::no_error};
     bool is_valid_{false};
     bool is_parsed_{false};
+    bool has_root{false};
     // parse context
+    JsonTreeParseOptions options{};
     size_t index{0};
-    char current_char{};
-    std::string_view last_token{};
-
-    void add_node(JsonNode* node);
-    void parse_skip_initial_whitespaces();
-    bool parse_rule_skip_whitespaces();
-    bool parse_rule_object_start();
-    bool parse_rule_object_end();
-    bool parse_rule_array_start();
-    bool parse_rule_array_end();
-    bool parse_rule_colon();
-    bool parse_rule_comma();
-    bool parse_rule_string();
-    bool parse_rule_number();
-    bool parse_rule_literal();
-
-    using parse_rule_t = bool(JsonTree::*)();
-    const std::array<parse_rule_t, 10> parse_rules{&JsonTree::parse_rule_skip_whitespaces,
-                                                   &JsonTree::parse_rule_object_start, &JsonTree::parse_rule_object_end,
-                                                   &JsonTree::parse_rule_array_start, &JsonTree::parse_rule_array_end,
-                                                   &JsonTree::parse_rule_colon, &JsonTree::parse_rule_comma,
-                                                   &JsonTree::parse_rule_string, &JsonTree::parse_rule_number,
-                                                   &JsonTree::parse_rule_literal};
+    char last_token{0}; // last structural character, 0 after value
+    // chunks
+    size_t offset{0}; // position of json data in the whole document
+    bool last_chunk{true}; // token may end at the end of json data
+    bool incomplete{false}; // token is cut by the end of chunk
+    std::vector<char> pending{}; // token cut by the end of the previous chunk
+    size_t pending_offset{0};
+
+    template <typename Event>
+    constexpr void emit(Event&& event);
+    constexpr bool add_element(Element element);
+    constexpr void close_parent();
+    template <typename Number>
+    constexpr void emit_number(Number number);
+    constexpr void parse_skip_initial_whitespaces();
+    constexpr void parse_tokens();
+    constexpr void parse_tokens_indexed();
+    constexpr void parse_token();
+    constexpr void parse_rule_skip_whitespaces();
+    constexpr void parse_rule_object_start();
+    constexpr void parse_rule_object_end();
+    constexpr void parse_rule_array_start();
+    constexpr void parse_rule_array_end();
+    constexpr void parse_rule_colon();
+    constexpr void parse_rule_comma();
+    constexpr void parse_rule_string();
+    constexpr void parse_string(size_t start, size_t end, bool has_escapes);
+    constexpr void parse_rule_number();
+    constexpr void parse_rule_literal();
+    constexpr size_t find_pending_token_end(std::string_view chunk) const;
+    constexpr void parse_chunk(std::string_view chunk, size_t chunk_offset, bool is_last);
 
 public:
-    explicit JsonTree(const std::string_view& json_data) : json_data(json_data) {}
-    JsonTree(const JsonTree& other) = delete;
-    JsonTree(JsonTree&& other) noexcept = delete;
+    constexpr JsonSaxParser(const std::string_view& json_data, Handler& handler)
+        : json_data(json_data), handler(handler) {}
 
-    ~JsonTree() {
-        for (const auto node_ptr : nodes) {
-            delete node_ptr;
-        }
+    /**
+     * Parser for data passed by feed()
+     */
+    constexpr explicit JsonSaxParser(Handler& handler, const JsonTreeParseOptions& options_ = {})
+        : handler(handler), options(options_) {}
+
+    /**
+     * Prepare parser for new json data, buffers keep their memory
+     */
+    constexpr void reset(const std::string_view json_data_ = {}) {
+        json_data = json_data_;
+        parents.clear();
+        strings.clear();
+        error_code = JsonTreeParseError::no_error;
+        is_valid_ = false;
+        is_parsed_ = false;
+        has_root = false;
+        index = 0;
+        last_token = 0;
+        offset = 0;
+        last_chunk = true;
+        incomplete = false;
+        pending.clear();
+        pending_offset = 0;
     }
 
-    [[nodiscard]] auto get_json_data() const { return json_data; }
-    [[nodiscard]] auto get_error_code() const { return error_code; }
-    [[nodiscard]] auto valid() const { return is_valid_; }
-    [[nodiscard]] auto parsed() const { return is_parsed_; }
-    [[nodiscard]] auto get_index() const { return index; }
-    [[nodiscard]] auto get_root() const { return nodes.front(); }
-    [[nodiscard]] auto empty() const { return nodes.empty(); }
-    [[nodiscard]] auto& get_nodes() const { return nodes; }
+    [[nodiscard]] constexpr auto get_json_data() const { return json_data; }
+    [[nodiscard]] constexpr auto get_error_code() const { return error_code; }
+    [[nodiscard]] constexpr auto valid() const { return is_valid_; }
+    [[nodiscard]] constexpr auto parsed() const { return is_parsed_; }
+    [[nodiscard]] constexpr auto get_index() const { return offset + index; }
+    [[nodiscard]] constexpr auto get_depth() const { return parents.size(); }
 
-    bool parse() {
+    /**
+     * Parse next chunk of data, returns false after error
+     */
+    constexpr bool feed(std::string_view chunk);
+
+    /**
+     * Parse token left at the end of the last chunk and check that document is complete
+     */
+    constexpr bool finish();
+
+    constexpr bool parse(const JsonTreeParseOptions& options_ = {}) {
         if (is_parsed_) { return is_valid_; }
         is_parsed_ = true;
+        options = options_;
         parse_skip_initial_whitespaces();
         if (index == json_data.size()) {
             error_code = JsonTreeParseError::empty_json_data;
             is_valid_ = false;
             return is_valid_;
         }
-        // std::cout << std::endl << "Data: " << json_data.substr(index) << std::endl;
-        while (index < json_data.size() && error_code == JsonTreeParseError::no_error) {
-            // std::cout << "Parsing: " << std::to_string(index) << "|" << last_token << "|" << std::endl;
-            current_char = json_data[index];
-            if (std::any_of
-                (
-                    parse_rules.begin(),
-                    parse_rules.end(),
-                    [this](const auto& rule) {
-                        return std::invoke(rule, this);
-                    }
-                    )) { continue; }
-            error_code = JsonTreeParseError::unknown_token;
-        }
-        // std::cout << "Parsing: " << std::to_string(index) << "|" << last_token << "|" << std::endl;
+        if (options.structural_index && json_data.size() <= UINT32_MAX && !std::is_constant_evaluated()) {
+            parse_tokens_indexed();
+        } else {
+            parse_tokens();
+        }
         // check parents
         if (error_code == JsonTreeParseError::no_error && !parents.empty()) {
             error_code = JsonTreeParseError::unexpected_end_of_data;
@@ -217,273 +979,793 @@ public:
         is_valid_ = error_code == JsonTreeParseError::no_error;
         return is_valid_;
     }
+
+    /**
+     * Parse items of array which is opened before begin, begin follows '[' or ',' and end is at ',' or ']'
+     * of the array. Events of the array itself are not emitted. Used by parallel parsing of one array.
+     */
+    constexpr bool parse_array_items(size_t begin, size_t end, const JsonTreeParseOptions& options_ = {});
 };
 
-inline void JsonTree::add_node(JsonNode* node) {
-    const auto is_nodes_empty = nodes.empty();
-    nodes.push_back(node);
-    // special case: if nodes are empty, then we want to add only container
-    if (is_nodes_empty) {
-        if (node->is_container()) {
-            parents.push(node);
-        } else {
+template <typename Handler>
+constexpr bool JsonSaxParser<Handler>::parse_array_items(const size_t begin, const size_t end,
+                                               const JsonTreeParseOptions& options_) {
+    if (is_parsed_) { return is_valid_; }
+    is_parsed_ = true;
+    options = options_;
+    has_root = true;
+    parents.push_back({JsonNodeType::array, 0});
+    last_token = '[';
+    const auto data = json_data;
+    json_data = data.substr(0, end);
+    index = begin;
+    parse_tokens();
+    json_data = data;
+    const auto after_item = last_token != '[' && last_token != ',';
+    if (error_code == JsonTreeParseError::no_error && (parents.size() != 1 || !after_item)) {
+        error_code = JsonTreeParseError::unexpected_end_of_data;
+    }
+    is_valid_ = error_code == JsonTreeParseError::no_error;
+    return is_valid_;
+}
+
+template <typename Handler>
+template <typename Event>
+constexpr void JsonSaxParser<Handler>::emit(Event&& event) {
+    if constexpr (std::is_same_v<decltype(event()), bool>) {
+        if (!event() && error_code == JsonTreeParseError::no_error) {
+            error_code = JsonTreeParseError::stopped_by_handler;
+        }
+    } else {
+        event();
+    }
+}
+
+/**
+ * Check if element may be placed at the current position. Strings placed in objects become keys.
+ */
+template <typename Handler>
+constexpr bool JsonSaxParser<Handler>::add_element(const Element element) {
+    const auto is_container = element == Element::object || element == Element::array;
+    const auto type = element == Element::object ? JsonNodeType::object : JsonNodeType::array;
+    // special case: first element must be container
+    if (!has_root) {
+        if (!is_container) {
             error_code = JsonTreeParseError::first_node_must_be_object_or_array;
+            return false;
         }
-        return;
+        has_root = true;
+        parents.push_back({type, 0});
+        return true;
     }
     // add element to object
     if (parents.empty()) {
         error_code = JsonTreeParseError::no_parent;
-        return;
+        return false;
     }
-    if (parents.top()->is_object()) {
-        if (last_token != "{" && last_token != ",") {
+    auto& parent = parents.back();
+    if (parent.type == JsonNodeType::object) {
+        if (last_token != '{' && last_token != ',') {
             error_code = JsonTreeParseError::missing_comma;
-            return;
+            return false;
         }
-        if (node->is_string()) {
-            node->set_key_type();
-            parents.top()->add_child(node);
-            parents.push(node); // move parent to key
-            return;
+        if (element == Element::string) {
+            ++parent.children_count;
+            parents.push_back({JsonNodeType::key, 0}); // move parent to key
+            return true;
         }
         error_code = JsonTreeParseError::key_must_be_string;
-        return;
+        return false;
     }
     // add element to array
-    if (parents.top()->is_array()) {
-        if (last_token != "[" && last_token != ",") {
+    if (parent.type == JsonNodeType::array) {
+        if (last_token != '[' && last_token != ',') {
             error_code = JsonTreeParseError::missing_comma;
-            return;
+            return false;
         }
-        parents.top()->add_child(node);
-        if (node->is_container()) {
-            parents.push(node);
+        ++parent.children_count;
+        if (is_container) {
+            parents.push_back({type, 0});
         }
-        return;
+        return true;
     }
     // add element to key
-    if (parents.top()->is_key()) {
-        if (last_token != ":") {
-            error_code = JsonTreeParseError::missing_colon;
-            return;
+    if (last_token != ':') {
+        error_code = JsonTreeParseError::missing_colon;
+        return false;
+    }
+    ++parent.children_count;
+    if (is_container) {
+        parents.push_back({type, 0});
+    } else {
+        parents.pop_back();
+    }
+    return true;
+}
+
+template <typename Handler>
+constexpr void JsonSaxParser<Handler>::close_parent() {
+    parents.pop_back();
+    if (!parents.empty() && parents.back().type == JsonNodeType::key) {
+        parents.pop_back(); // container was value of key, so pop key
+    }
+}
+
+template <typename Handler>
+template <typename Number>
+constexpr void JsonSaxParser<Handler>::emit_number(const Number number) {
+    if constexpr (std::is_same_v<Number, int>) {
+        emit([&] { return handler.on_int(number); });
+    } else if constexpr (std::is_same_v<Number, int64_t>) {
+        emit([&] { return handler.on_int64(number); });
+    } else if constexpr (std::is_same_v<Number, uint64_t>) {
+        emit([&] { return handler.on_uint64(number); });
+    } else {
+        emit([&] { return handler.on_double(number); });
+    }
+}
+
+template <typename Handler>
+constexpr void JsonSaxParser<Handler>::parse_tokens() {
+    while (index < json_data.size() && error_code == JsonTreeParseError::no_error && !incomplete) {
+        parse_token();
+    }
+}
+
+/**
+ * Drive rules from structural index: whitespace runs are skipped in one step and strings end at known quote.
+ * Bytes which are not in the index (e.g. rest of malformed literal) are handled by regular rules.
+ */
+template <typename Handler>
+constexpr void JsonSaxParser<Handler>::parse_tokens_indexed() {
+    json_build_structural_index(json_data, positions);
+    size_t next = 0;
+    while (index < json_data.size() && error_code == JsonTreeParseError::no_error) {
+        while (next < positions.size() && positions[next] < index) {
+            ++next;
         }
-        parents.top()->add_child(node);
-        if (node->is_container()) {
-            parents.push(node);
-        } else {
-            parents.pop();
+        const auto position = next < positions.size() ? positions[next] : json_data.size();
+        const auto token_class = json_token_classes[static_cast<uint8_t>(json_data[index])];
+        if (index < position && token_class == JsonTokenClass::whitespace) {
+            index = position; // only whitespaces are between token end and next structural position
+            continue;
         }
-        return;
+        if (token_class == JsonTokenClass::string && index == position && next + 1 < positions.size()) {
+            const auto end = positions[next + 1];
+            parse_string(index + 1, end, json_find_quote_or_backslash(json_data.substr(0, end), index + 1) < end);
+            continue;
+        }
+        parse_token();
     }
-    // impossible to be here
-    error_code = JsonTreeParseError::unexpected_node;
 }
 
-inline void JsonTree::parse_skip_initial_whitespaces() {
-    while (index < json_data.size() && std::isspace(json_data[index])) {
-        index++;
+template <typename Handler>
+constexpr void JsonSaxParser<Handler>::parse_token() {
+    switch (json_token_classes[static_cast<uint8_t>(json_data[index])]) {
+    case JsonTokenClass::whitespace:
+        parse_rule_skip_whitespaces();
+        break;
+    case JsonTokenClass::object_start:
+        parse_rule_object_start();
+        break;
+    case JsonTokenClass::object_end:
+        parse_rule_object_end();
+        break;
+    case JsonTokenClass::array_start:
+        parse_rule_array_start();
+        break;
+    case JsonTokenClass::array_end:
+        parse_rule_array_end();
+        break;
+    case JsonTokenClass::colon:
+        parse_rule_colon();
+        break;
+    case JsonTokenClass::comma:
+        parse_rule_comma();
+        break;
+    case JsonTokenClass::string:
+        parse_rule_string();
+        break;
+    case JsonTokenClass::number:
+        parse_rule_number();
+        break;
+    case JsonTokenClass::literal:
+        parse_rule_literal();
+        break;
+    default:
+        error_code = JsonTreeParseError::unknown_token;
+        break;
     }
 }
 
+template <typename Handler>
+constexpr void JsonSaxParser<Handler>::parse_skip_initial_whitespaces() {
+    index = json_skip_whitespaces(json_data, index);
+}
+
 /**
- * Rule must return true if applied
+ * Rule is called by parse() for the token class of current character
  */
 
-inline bool JsonTree::parse_rule_skip_whitespaces() {
-    if (std::isspace(current_char)) {
-        index++;
-        return true;
+template <typename Handler>
+constexpr void JsonSaxParser<Handler>::parse_rule_skip_whitespaces() {
+    index = json_skip_whitespaces(json_data, index + 1);
+}
+
+template <typename Handler>
+constexpr void JsonSaxParser<Handler>::parse_rule_object_start() {
+    index++;
+    if (add_element(Element::object)) {
+        emit([&] { return handler.on_object_start(); });
     }
-    return false;
+    last_token = json_data[index - 1];
 }
 
-inline bool JsonTree::parse_rule_object_start() {
-    if (current_char == '{') {
-        index++;
-        add_node(new JsonNode(JsonNodeType::object));
-        last_token = json_data.substr(index - 1, 1);
-        return true;
+template <typename Handler>
+constexpr void JsonSaxParser<Handler>::parse_rule_object_end() {
+    if (last_token == ',') {
+        error_code = JsonTreeParseError::trailing_comma;
+        return;
+    }
+    if (parents.empty()) {
+        error_code = JsonTreeParseError::end_of_object_without_begin;
+        return;
     }
-    return false;
+    if (parents.back().type != JsonNodeType::object) {
+        error_code = JsonTreeParseError::end_of_object_mismatch;
+        return;
+    }
+    close_parent();
+    emit([&] { return handler.on_object_end(); });
+    index++;
+    last_token = json_data[index - 1];
 }
 
-inline bool JsonTree::parse_rule_object_end() {
-    if (current_char == '}') {
-        if (last_token == ",") {
-            error_code = JsonTreeParseError::trailing_comma;
-            return true;
+template <typename Handler>
+constexpr void JsonSaxParser<Handler>::parse_rule_array_start() {
+    index++;
+    if (add_element(Element::array)) {
+        emit([&] { return handler.on_array_start(); });
+    }
+    last_token = json_data[index - 1];
+}
+
+template <typename Handler>
+constexpr void JsonSaxParser<Handler>::parse_rule_array_end() {
+    if (last_token == ',') {
+        error_code = JsonTreeParseError::trailing_comma;
+        return;
+    }
+    if (parents.empty()) {
+        error_code = JsonTreeParseError::end_of_array_without_begin;
+        return;
+    }
+    if (parents.back().type != JsonNodeType::array) {
+        error_code = JsonTreeParseError::end_of_array_mismatch;
+        return;
+    }
+    close_parent();
+    emit([&] { return handler.on_array_end(); });
+    index++;
+    last_token = json_data[index - 1];
+}
+
+template <typename Handler>
+constexpr void JsonSaxParser<Handler>::parse_rule_colon() {
+    if (parents.empty() or parents.back().type != JsonNodeType::key) {
+        error_code = JsonTreeParseError::colon_without_object;
+        return;
+    }
+    index++;
+    last_token = json_data[index - 1];
+}
+
+template <typename Handler>
+constexpr void JsonSaxParser<Handler>::parse_rule_comma() {
+    // TODO: Check if this case is possible
+    if (parents.empty() || parents.back().type == JsonNodeType::key) {
+        error_code = JsonTreeParseError::comma_without_array_or_object;
+        return;
+    }
+    if (parents.back().children_count == 0) {
+        error_code = JsonTreeParseError::comma_without_children;
+        return;
+    }
+    index++;
+    last_token = json_data[index - 1];
+}
+
+template <typename Handler>
+constexpr void JsonSaxParser<Handler>::parse_rule_string() {
+    const size_t start = index + 1; // Skip the opening quote
+    bool has_escapes;
+    const auto end = json_find_string_end(json_data, start, has_escapes);
+    if (end == json_data.size() && !last_chunk) {
+        incomplete = true;
+        return;
+    }
+    parse_string(start, end, has_escapes);
+}
+
+template <typename Handler>
+constexpr void JsonSaxParser<Handler>::parse_string(const size_t start, const size_t end, const bool has_escapes) {
+    auto value = json_data.substr(start, end - start);
+    if (has_escapes && options.decode_escapes && end < json_data.size()) {
+        strings.clear();
+        const auto invalid = json_decode_string(value, strings);
+        if (invalid != value.size()) {
+            error_code = JsonTreeParseError::invalid_escape_sequence;
+            index = start + invalid;
+            return;
         }
-        if (parents.empty()) {
-            error_code = JsonTreeParseError::end_of_object_without_begin;
-            return true;
+        value = std::string_view(strings.data(), strings.size());
+    }
+    if (add_element(Element::string)) {
+        if (parents.back().type == JsonNodeType::key && parents.back().children_count == 0) {
+            if constexpr (requires { handler.on_key(value, has_escapes); }) {
+                emit([&] { return handler.on_key(value, has_escapes); });
+            } else {
+                emit([&] { return handler.on_key(value); });
+            }
+        } else {
+            if constexpr (requires { handler.on_string(value, has_escapes); }) {
+                emit([&] { return handler.on_string(value, has_escapes); });
+            } else {
+                emit([&] { return handler.on_string(value); });
+            }
         }
-        if (!parents.empty() && !parents.top()->is_object()) {
-            error_code = JsonTreeParseError::end_of_object_mismatch;
-            return true;
+    }
+    index = end + 1; // Skip the closing quote
+    last_token = 0;
+}
+
+template <typename Handler>
+constexpr void JsonSaxParser<Handler>::parse_rule_number() {
+    const size_t start = index;
+    bool is_double;
+    error_code = json_scan_number(json_data, index, is_double);
+    if (error_code != JsonTreeParseError::no_error) {
+        return;
+    }
+    if (index == json_data.size() && !last_chunk) {
+        incomplete = true;
+        index = start;
+        return;
+    }
+    const auto value = json_data.substr(start, index - start);
+    if constexpr (requires { handler.on_raw_number(JsonValueType::v_int, value); }) {
+        if (options.lazy_numbers && json_is_number_lazy_decodable(value)) {
+            if (add_element(Element::scalar)) {
+                const auto number_type = is_double ? JsonValueType::v_double : JsonValueType::v_int;
+                emit([&] { return handler.on_raw_number(number_type, value); });
+            }
+            last_token = 0;
+            return;
         }
-        parents.pop();
-        if (!parents.empty() && parents.top()->is_key()) {
-            parents.pop(); // object was value of key, so pop key
+    }
+    const auto number_error = json_visit_number(value, is_double, [&](const auto number) {
+        if (add_element(Element::scalar)) {
+            emit_number(number);
         }
-        index++;
-        last_token = json_data.substr(index - 1, 1);
-        return true;
+    });
+    if (number_error != JsonTreeParseError::no_error) {
+        error_code = number_error;
+        return;
     }
-    return false;
+    last_token = 0;
 }
 
-inline bool JsonTree::parse_rule_array_start() {
-    if (current_char == '[') {
+template <typename Handler>
+constexpr void JsonSaxParser<Handler>::parse_rule_literal() {
+    const size_t start = index;
+    while (index < json_data.size() && json_is_alpha(json_data[index])) {
         index++;
-        add_node(new JsonNode(JsonNodeType::array));
-        last_token = json_data.substr(index - 1, 1);
-        return true;
     }
-    return false;
+    if (index == json_data.size() && !last_chunk) {
+        incomplete = true;
+        index = start;
+        return;
+    }
+    const auto literal = json_data.substr(start, index - start);
+    if (literal != "true" && literal != "false" && literal != "null") {
+        error_code = JsonTreeParseError::unexpected_literal;
+        return;
+    }
+    if (add_element(Element::scalar)) {
+        if (literal == "null") {
+            emit([&] { return handler.on_null(); });
+        } else {
+            emit([&] { return handler.on_boolean(literal == "true"); });
+        }
+    }
+    last_token = 0;
 }
 
-inline bool JsonTree::parse_rule_array_end() {
-    if (current_char == ']') {
-        if (last_token == ",") {
-            error_code = JsonTreeParseError::trailing_comma;
-            return true;
-        }
-        if (parents.empty()) {
-            error_code = JsonTreeParseError::end_of_array_without_begin;
-            return true;
+
+/**
+ * Number of bytes of chunk which belong to the pending token, npos if the token does not end in chunk
+ */
+template <typename Handler>
+constexpr size_t JsonSaxParser<Handler>::find_pending_token_end(const std::string_view chunk) const {
+    if (pending.front() == '"') {
+        // odd run of backslashes at the end of pending string escapes the first byte of chunk
+        size_t backslashes = 0;
+        for (auto i = pending.size() - 1; i > 0 && pending[i] == '\\'; --i) {
+            ++backslashes;
         }
-        if (!parents.top()->is_array()) {
-            error_code = JsonTreeParseError::end_of_array_mismatch;
-            return true;
+        const size_t start = backslashes % 2;
+        if (start > chunk.size()) {
+            return std::string_view::npos;
         }
-        parents.pop();
-        if (!parents.empty() && parents.top()->is_key()) {
-            parents.pop(); // object was value of key, so pop key
+        const auto end = json_find_string_end(chunk, start);
+        return end < chunk.size() ? end + 1 : std::string_view::npos;
+    }
+    const auto is_literal = json_is_alpha(pending.front());
+    for (size_t i = 0; i < chunk.size(); ++i) {
+        if (is_literal ? !json_is_alpha(chunk[i]) : !json_is_number_char(chunk[i])) {
+            return i;
         }
-        index++;
-        last_token = json_data.substr(index - 1, 1);
-        return true;
     }
-    return false;
+    return std::string_view::npos;
 }
 
-inline bool JsonTree::parse_rule_colon() {
-    if (current_char == ':') {
-        if (parents.empty() or !parents.top()->is_key()) {
-            error_code = JsonTreeParseError::colon_without_object;
-            return true;
-        }
-        index++;
-        last_token = json_data.substr(index - 1, 1);
-        return true;
-    }
-    return false;
+template <typename Handler>
+constexpr void JsonSaxParser<Handler>::parse_chunk(const std::string_view chunk, const size_t chunk_offset,
+                                                   const bool is_last) {
+    json_data = chunk;
+    offset = chunk_offset;
+    index = 0;
+    last_chunk = is_last;
+    parse_tokens();
 }
 
-inline bool JsonTree::parse_rule_comma() {
-    if (current_char == ',') {
-        // TODO: Check if this case is possible
-        if (parents.empty() || !parents.top()->is_container()) {
-            error_code = JsonTreeParseError::comma_without_array_or_object;
+template <typename Handler>
+constexpr bool JsonSaxParser<Handler>::feed(std::string_view chunk) {
+    if (is_parsed_ || error_code != JsonTreeParseError::no_error) {
+        return false;
+    }
+    const auto chunk_offset = offset + json_data.size();
+    size_t start = 0;
+    if (!pending.empty()) {
+        const auto end = find_pending_token_end(chunk);
+        if (end == std::string_view::npos) {
+            pending.insert(pending.end(), chunk.begin(), chunk.end());
+            json_data = {};
+            offset = chunk_offset + chunk.size();
             return true;
         }
-        if (parents.top()->get_children().empty()) {
-            error_code = JsonTreeParseError::comma_without_children;
-            return true;
+        pending.insert(pending.end(), chunk.begin(), chunk.begin() + static_cast<std::ptrdiff_t>(end));
+        parse_chunk({pending.data(), pending.size()}, pending_offset, true);
+        pending.clear();
+        if (error_code != JsonTreeParseError::no_error) {
+            return false;
         }
-        index++;
-        last_token = json_data.substr(index - 1, 1);
-        return true;
+        start = end;
+    }
+    parse_chunk(chunk.substr(start), chunk_offset + start, false);
+    if (incomplete) {
+        pending.assign(json_data.begin() + static_cast<std::ptrdiff_t>(index), json_data.end());
+        pending_offset = offset + index;
+        incomplete = false;
     }
-    return false;
+    return error_code == JsonTreeParseError::no_error;
 }
 
-inline bool JsonTree::parse_rule_string() {
-    if (current_char == '"') {
-        const size_t start = ++index; // Skip the opening quote
-        while (index < json_data.size() && json_data[index] != '"') {
-            if (json_data[index] == '\\' && index + 1 < json_data.size()) {
-                // Handle escape sequences
-                index++;
-            }
-            index++;
-        }
-        const auto value = json_data.substr(start, index - start);
-        add_node(new JsonNode(value));
-        index++; // Skip the closing quote
-        last_token = json_data.substr(start - 1, index - start + 1); // last token with quotes
-        return true;
+template <typename Handler>
+constexpr bool JsonSaxParser<Handler>::finish() {
+    if (is_parsed_) { return is_valid_; }
+    is_parsed_ = true;
+    if (error_code == JsonTreeParseError::no_error && !pending.empty()) {
+        parse_chunk({pending.data(), pending.size()}, pending_offset, true);
+        pending.clear();
     }
-    return false;
-}
-
-inline bool JsonTree::parse_rule_number() {
-    if (std::isdigit(current_char) || current_char == '-') {
-        bool contains_dot = false;
-        bool contains_e = false;
-        const size_t start = index;
-        while (index < json_data.size() && (std::isdigit
-            (json_data[index]) || json_data[index] == '.' || json_data[index] == 'e' || json_data[index] == 'E' ||
-            json_data[index] == '+' || json_data[index] == '-')) {
-            if (json_data[index] == '.') {
-                if (contains_dot) {
-                    error_code = JsonTreeParseError::invalid_number_literal;
-                    return true;
-                }
-                contains_dot = true;
-            }
-            if (json_data[index] == 'e' || json_data[index] == 'E') {
-                if (contains_e) {
-                    error_code = JsonTreeParseError::invalid_number_literal;
-                    return true;
-                }
-                contains_e = true;
-            }
-            if (json_data[index] == '-' && start != index && json_data[index - 1] != 'e' && json_data[index - 1] !=
-                'E') {
-                error_code = JsonTreeParseError::invalid_number_literal;
-                return true;
-            }
-            if (json_data[index] == '+' && json_data[index - 1] != 'e' && json_data[index - 1] != 'E') {
-                error_code = JsonTreeParseError::invalid_number_literal;
-                return true;
-            }
-            index++;
-        }
-        const auto value = json_data.substr(start, index - start);
-        if (contains_dot || contains_e) {
-            add_node(new JsonNode(std::stod(std::string(value))));
-        } else {
-            add_node(new JsonNode(std::stoi(std::string(value))));
-        }
-        last_token = value;
+    if (error_code == JsonTreeParseError::no_error && !has_root) {
+        error_code = JsonTreeParseError::empty_json_data;
+    }
+    // check parents
+    if (error_code == JsonTreeParseError::no_error && !parents.empty()) {
+        error_code = JsonTreeParseError::unexpected_end_of_data;
+    }
+    is_valid_ = error_code == JsonTreeParseError::no_error;
+    return is_valid_;
+}
+
+
+/**
+ * Handler of JsonSaxParser which builds nodes of a tree.
+ *
+ * Nodes go into an arena, strings which are not views of json data (decoded escape sequences, parts of chunks)
+ * go into a strings buffer and big objects get the key index pool. All three are owned by the result (JsonTree or
+ * JsonDocument), builder keeps only the stack of open containers, which is reused after reset().
+ */
+class JsonTreeBuilder {
+    struct DecodedString {
+        uint32_t node;
+        size_t offset;
+        size_t size;
+    };
+
+    std::string_view json_data{};
+    JsonNodeArena* nodes{nullptr};
+    std::vector<char>* strings{nullptr};
+    JsonKeyIndexPool* key_indexes{nullptr};
+    size_t indexed_objects{0}; // objects big enough to be indexed
+    size_t key_indexes_size{0}; // memory of their indexes, when all are built
+    std::vector<uint32_t> parents{}; // indexes of open containers and keys
+    std::vector<DecodedString> decoded_strings{}; // strings buffer may move, so nodes are pointed to it at the end
+
+    JsonNode& parent() { return (*nodes)[parents.back()]; }
+    void close_parent();
+    bool add_node(JsonNode* node);
+    bool add_string(std::string_view value, bool has_escapes, bool is_key);
+    bool copy_string(JsonNode* node, std::string_view value);
+    bool on_container_end();
+
+public:
+    JsonTreeBuilder() = default;
+
+    JsonTreeBuilder(const JsonTreeBuilder& other) = delete;
+    JsonTreeBuilder(JsonTreeBuilder&& other) noexcept = delete;
+
+    /**
+     * Start new tree of json data in given storage, storage is not cleared
+     */
+    void reset(const std::string_view json_data_, JsonNodeArena& nodes_, std::vector<char>& strings_,
+               JsonKeyIndexPool& key_indexes_) {
+        json_data = json_data_;
+        nodes = &nodes_;
+        strings = &strings_;
+        key_indexes = &key_indexes_;
+        indexed_objects = 0;
+        key_indexes_size = 0;
+        parents.clear();
+        decoded_strings.clear();
+    }
+
+    /**
+     * Point string nodes to the strings buffer, called when parsing is done
+     */
+    void finish();
+
+    [[nodiscard]] auto get_indexed_objects() const { return indexed_objects; }
+    [[nodiscard]] auto get_key_indexes_size() const { return key_indexes_size; }
+
+    // events of JsonSaxParser, false when node can not be created
+    bool on_object_start() { return add_node(nodes->create(JsonNodeType::object)); }
+    bool on_array_start() { return add_node(nodes->create(JsonNodeType::array)); }
+    bool on_object_end() { return on_container_end(); }
+    bool on_array_end() { return on_container_end(); }
+    bool on_key(const std::string_view key, const bool has_escapes) { return add_string(key, has_escapes, true); }
+
+    bool on_string(const std::string_view value, const bool has_escapes) {
+        return add_string(value, has_escapes, false);
+    }
+
+    bool on_int(const int value) { return add_node(nodes->create(value)); }
+    bool on_int64(const int64_t value) { return add_node(nodes->create(value)); }
+    bool on_uint64(const uint64_t value) { return add_node(nodes->create(value)); }
+    bool on_double(const double value) { return add_node(nodes->create(value)); }
+    bool on_boolean(const bool value) { return add_node(nodes->create(value)); }
+    bool on_null() { return add_node(nodes->create()); }
+
+    bool on_raw_number(const JsonValueType number_type, const std::string_view raw) {
+        const auto node = nodes->create(number_type, raw);
+        return node != nullptr && copy_string(node, raw) && add_node(node);
+    }
+};
+
+inline void JsonTreeBuilder::close_parent() {
+    auto& node = parent();
+    node.subtree_size = static_cast<uint32_t>(nodes->size() - parents.back());
+    if (node.is_object() && node.children_count >= json_key_index_min_keys) {
+        // index itself is built by the first find()
+        node.value.v_key_index.pool = key_indexes;
+        ++indexed_objects;
+        key_indexes_size += JsonKeyIndex::memory_size(node.children_count);
+    }
+    parents.pop_back();
+}
+
+/**
+ * Link node created by event with its parent, grammar is already checked by the parser
+ */
+inline bool JsonTreeBuilder::add_node(JsonNode* node) {
+    if (node == nullptr) {
+        return false;
+    }
+    const auto node_index = static_cast<uint32_t>(nodes->size() - 1);
+    if (!parents.empty()) {
+        ++parent().children_count;
+    }
+    if (node->is_container() || node->is_key()) {
+        parents.push_back(node_index);
+    } else if (parent().is_key()) {
+        close_parent();
+    }
+    return true;
+}
+
+inline bool JsonTreeBuilder::on_container_end() {
+    close_parent();
+    if (!parents.empty() && parent().is_key()) {
+        close_parent(); // container was value of key, so pop key
+    }
+    return true;
+}
+
+/**
+ * Strings without escape sequences are views of json data, decoded strings are copied into one buffer per tree
+ */
+inline bool JsonTreeBuilder::add_string(const std::string_view value, const bool has_escapes, const bool is_key) {
+    const auto node = nodes->create(value);
+    if (node == nullptr || !copy_string(node, value)) {
+        return false;
+    }
+    if (has_escapes) {
+        node->flags |= JsonNode::escapes_flag;
+    }
+    if (is_key) {
+        node->set_key_type();
+    }
+    return add_node(node);
+}
+
+/**
+ * Copy text which is not part of json data (decoded string or chunk) into the tree
+ */
+inline bool JsonTreeBuilder::copy_string(JsonNode* node, const std::string_view value) {
+    if (value.data() >= json_data.data() && value.data() <= json_data.data() + json_data.size()) {
         return true;
     }
-    return false;
+    decoded_strings.push_back({static_cast<uint32_t>(nodes->size() - 1), strings->size(), value.size()});
+    strings->insert(strings->end(), value.begin(), value.end());
+    node->value.v_string = {};
+    return true;
 }
 
-inline bool JsonTree::parse_rule_literal() {
-    if (std::isalpha(current_char)) {
-        const size_t start = index;
-        while (index < json_data.size() && std::isalpha(json_data[index])) {
-            index++;
-        }
-        const auto literal = json_data.substr(start, index - start);
-        if (literal == "true" || literal == "false") {
-            add_node(new JsonNode(literal == "true"));
-            last_token = literal;
-            return true;
+inline void JsonTreeBuilder::finish() {
+    for (const auto& decoded : decoded_strings) {
+        (*nodes)[decoded.node].value.v_string = std::string_view(strings->data() + decoded.offset, decoded.size);
+    }
+    decoded_strings.clear();
+}
+
+
+/**
+ * Storage of a tree which is filled without JsonTree::parse(), see JsonTree::get_storage()
+ */
+struct JsonTreeStorage {
+    JsonNodeArena& nodes;
+    std::vector<char>& strings; // decoded strings, string nodes point into it
+    JsonKeyIndexPool& key_indexes; // big objects point to it
+};
+
+/**
+ * Tree of nodes, built by JsonSaxParser with JsonTreeBuilder as its handler.
+ *
+ * Tree is built from the whole json data by parse(), or from chunks by feed() and finish(). Strings and numbers
+ * of chunked tree are copied into the tree, because chunks may be gone when the tree is used.
+ */
+class JsonTree {
+    const std::string_view json_data;
+    JsonNodeArena own_arena{};
+    JsonNodeArena& nodes;
+    std::vector<char> strings{}; // decoded strings which contain escape sequences
+    JsonKeyIndexPool key_indexes{};
+    JsonTreeBuilder builder{};
+    JsonTreeParseError error_code{JsonTreeParseError::no_error};
+    bool is_valid_{false};
+    bool is_parsed_{false};
+    JsonTreeParseOptions options{};
+    size_t index{0};
+    std::unique_ptr<JsonSaxParser<JsonTreeBuilder>> stream{}; // parser of chunks
+
+    bool set_result(const JsonSaxParser<JsonTreeBuilder>& parser);
+
+public:
+    explicit JsonTree(const std::string_view& json_data) : json_data(json_data), nodes(own_arena) {}
+
+    /**
+     * Build tree in caller supplied arena, arena must be empty and must outlive the tree.
+     */
+    JsonTree(const std::string_view& json_data, JsonNodeArena& arena) : json_data(json_data), nodes(arena) {}
+
+    /**
+     * Tree built from chunks passed to feed()
+     */
+    JsonTree() : nodes(own_arena) {}
+
+    explicit JsonTree(JsonNodeArena& arena) : nodes(arena) {}
+
+    JsonTree(const JsonTree& other) = delete;
+    JsonTree(JsonTree&& other) noexcept = delete;
+
+    ~JsonTree() { nodes.clear(); }
+
+    [[nodiscard]] auto get_json_data() const { return json_data; }
+    [[nodiscard]] auto get_error_code() const { return error_code; }
+    [[nodiscard]] auto valid() const { return is_valid_; }
+    [[nodiscard]] auto parsed() const { return is_parsed_; }
+    [[nodiscard]] auto get_index() const { return index; }
+    [[nodiscard]] auto get_root() const { return nodes.front(); }
+    [[nodiscard]] auto& get_arena() const { return nodes; }
+    [[nodiscard]] auto empty() const { return nodes.empty(); }
+    [[nodiscard]] auto& get_nodes() const { return nodes; }
+    [[nodiscard]] auto& get_options() const { return options; }
+
+    bool parse(const JsonTreeParseOptions& options_ = {}) {
+        if (is_parsed_) { return is_valid_; }
+        is_parsed_ = true;
+        options = options_;
+        builder.reset(json_data, nodes, strings, key_indexes);
+        JsonSaxParser<JsonTreeBuilder> parser(json_data, builder);
+        parser.parse(options);
+        return set_result(parser);
+    }
+
+    /**
+     * Storage for parsers which build the tree themselves (e.g. JsonParallelParser), set_built() ends such build.
+     * Tree must not be parsed yet.
+     */
+    [[nodiscard]] JsonTreeStorage get_storage() { return {nodes, strings, key_indexes}; }
+
+    /**
+     * Mark tree filled through get_storage() as parsed and valid
+     */
+    void set_built(const JsonTreeParseOptions& options_) {
+        is_parsed_ = true;
+        is_valid_ = true;
+        options = options_;
+        error_code = JsonTreeParseError::no_error;
+        index = json_data.size();
+    }
+
+    /**
+     * Options of chunked tree, must be set before the first feed()
+     */
+    void set_options(const JsonTreeParseOptions& options_) { options = options_; }
+
+    /**
+     * Parse next chunk of data, chunk may be released after the call. Returns false after error.
+     */
+    bool feed(const std::string_view chunk) {
+        if (is_parsed_) { return false; }
+        if (!stream) {
+            builder.reset(json_data, nodes, strings, key_indexes);
+            stream = std::make_unique<JsonSaxParser<JsonTreeBuilder>>(builder, options);
         }
-        if (literal == "null") {
-            add_node(new JsonNode());
-            last_token = literal;
-            return true;
+        const auto result = stream->feed(chunk);
+        error_code = stream->get_error_code();
+        index = stream->get_index();
+        return result;
+    }
+
+    /**
+     * End of data, tree is ready. Returns true if tree is valid.
+     */
+    bool finish() {
+        if (is_parsed_) { return is_valid_; }
+        is_parsed_ = true;
+        if (!stream) {
+            builder.reset(json_data, nodes, strings, key_indexes);
+            stream = std::make_unique<JsonSaxParser<JsonTreeBuilder>>(builder, options);
         }
-        error_code = JsonTreeParseError::unexpected_literal;
-        return true;
+        stream->finish();
+        const auto result = set_result(*stream);
+        stream.reset();
+        return result;
+    }
+};
+
+inline bool JsonTree::set_result(const JsonSaxParser<JsonTreeBuilder>& parser) {
+    builder.finish();
+    error_code = parser.get_error_code();
+    if (error_code == JsonTreeParseError::stopped_by_handler) {
+        error_code = JsonTreeParseError::out_of_memory; // the only reason to stop
     }
-    return false;
+    index = parser.get_index();
+    is_valid_ = error_code == JsonTreeParseError::no_error;
+    return is_valid_;
 }
 
 #endif //__jsontree__jsontree_hpp
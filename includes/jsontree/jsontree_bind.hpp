@@ -0,0 +1,489 @@
+/*
+ * jsontree - JSON Parsing and library in C++20
+ * Copyright 2025 Marcin Markiewicz, marcin.kivrin@gmail.com
+ *
+ * This file is a part of jsontree project
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * Project: jsontree
+ *
+ */
+
+#ifndef __jsontree__jsontree_bind_hpp
+#define __jsontree__jsontree_bind_hpp
+
+
+#include <array>
+#include <bit>
+#include <charconv>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "jsontree.hpp"
+#include "jsontree_cursor.hpp"
+
+
+/**
+ * Binding of json data to user types, values are written straight into the struct without building nodes.
+ *
+ * Struct is bound by specializing JsonFields with a tuple of its fields:
+ *
+ *     template <>
+ *     struct JsonFields<PlayerSettings> {
+ *         static constexpr std::tuple fields{json_field("name", &PlayerSettings::name),
+ *                                            json_field("age", &PlayerSettings::age)};
+ *     };
+ *
+ * Fields may be bool, numbers, std::string, std::optional, std::array, std::vector and other bound structs.
+ * Keys are found with a perfect hash computed at compile time. Unknown keys are skipped, missing keys leave
+ * fields unchanged, values of wrong type are reported as value_type_mismatch.
+ */
+template <typename T>
+struct JsonFields;
+
+template <typename T, typename Member>
+struct JsonField {
+    std::string_view name;
+    Member T::* member;
+};
+
+template <typename T, typename Member>
+constexpr JsonField<T, Member> json_field(const std::string_view name, Member T::* member) {
+    return {name, member};
+}
+
+template <typename T>
+concept JsonBoundStruct = requires { JsonFields<T>::fields; };
+
+template <typename T>
+struct JsonIsOptional : std::false_type {};
+
+template <typename T>
+struct JsonIsOptional<std::optional<T>> : std::true_type {};
+
+template <typename T>
+struct JsonIsArray : std::false_type {};
+
+template <typename T, size_t N>
+struct JsonIsArray<std::array<T, N>> : std::true_type {};
+
+template <typename T>
+struct JsonIsVector : std::false_type {};
+
+template <typename T, typename Allocator>
+struct JsonIsVector<std::vector<T, Allocator>> : std::true_type {};
+
+/**
+ * Slot of a key is json_key_hash(key, seed) & (size - 1), seed is searched until keys take different slots
+ */
+struct JsonPerfectHash {
+    uint32_t seed{0};
+    size_t size{0}; // power of 2, 0 when names are not unique
+
+    static constexpr uint32_t slot(const std::string_view key, const uint32_t seed, const size_t size) {
+        const auto hash = json_key_hash(key, seed);
+        return (hash ^ hash >> 16) & static_cast<uint32_t>(size - 1);
+    }
+};
+
+template <size_t N>
+constexpr JsonPerfectHash json_find_perfect_hash(const std::array<std::string_view, N>& names) {
+    constexpr uint32_t seeds_per_size = 256;
+    for (size_t i = 0; i < N; ++i) {
+        for (size_t j = i + 1; j < N; ++j) {
+            if (names[i] == names[j]) {
+                return {}; // no seed separates equal names, do not try them all
+            }
+        }
+    }
+    for (size_t size = std::bit_ceil(std::max<size_t>(2 * N, 1)); size <= 65536; size *= 2) {
+        for (uint32_t seed = 1; seed <= seeds_per_size; ++seed) {
+            std::vector<bool> used(size);
+            bool collision = false;
+            for (const auto name : names) {
+                const auto slot = JsonPerfectHash::slot(name, seed * 2654435761u, size);
+                collision = collision || used[slot];
+                used[slot] = true;
+            }
+            if (!collision) {
+                return {seed * 2654435761u, size};
+            }
+        }
+    }
+    return {};
+}
+
+/**
+ * Compile time tables of bound struct: field names, perfect hash slots and readers of fields
+ */
+template <typename T>
+class JsonStructBinding {
+    using Fields = std::remove_cvref_t<decltype(JsonFields<T>::fields)>;
+    static constexpr size_t count = std::tuple_size_v<Fields>;
+    static constexpr uint16_t empty_slot = 0xFFFF;
+
+    template <size_t... I>
+    static constexpr std::array<std::string_view, count> make_names(std::index_sequence<I...>) {
+        return {std::get<I>(JsonFields<T>::fields).name...};
+    }
+
+    static constexpr auto names = make_names(std::make_index_sequence<count>{});
+    static constexpr auto hash = json_find_perfect_hash(names);
+    static_assert(count < empty_slot, "too many fields");
+    static_assert(hash.size > 0, "field names must be unique");
+
+    static constexpr std::array<uint16_t, hash.size> make_slots() {
+        std::array<uint16_t, hash.size> slots{};
+        slots.fill(empty_slot);
+        for (uint16_t field = 0; field < count; ++field) {
+            slots[JsonPerfectHash::slot(names[field], hash.seed, hash.size)] = field;
+        }
+        return slots;
+    }
+
+    static constexpr auto slots = make_slots();
+
+public:
+    static constexpr size_t npos = count;
+
+    /**
+     * Field with given key name, npos if there is none
+     */
+    static constexpr size_t find(const std::string_view key) {
+        const auto field = slots[JsonPerfectHash::slot(key, hash.seed, hash.size)];
+        return field != empty_slot && names[field] == key ? field : npos;
+    }
+
+    template <typename Reader, size_t I = 0>
+    static bool read_field(const size_t field, Reader& reader, T& value) {
+        if constexpr (I < count) {
+            if (field == I) {
+                return reader.read(value.*(std::get<I>(JsonFields<T>::fields).member));
+            }
+            return read_field<Reader, I + 1>(field, reader, value);
+        } else {
+            return false;
+        }
+    }
+};
+
+/**
+ * Recursive reader of one value into user type, checks the same grammar as the parser for values it reads
+ */
+class JsonBindReader {
+    std::string_view json_data;
+    size_t index{0};
+    JsonTreeParseError error_code{JsonTreeParseError::no_error};
+    std::string key{}; // decoded key with escape sequences
+
+    bool fail(const JsonTreeParseError error) {
+        error_code = error;
+        return false;
+    }
+
+    std::string_view read_literal();
+    bool read_boolean(bool& value);
+    bool read_null();
+    template <typename T>
+    bool read_number(T& value);
+    bool read_string(std::string& value);
+    template <typename F>
+    bool read_items(F&& read_item);
+    template <typename T>
+    bool read_object(T& value);
+    bool read_key(std::string_view& name);
+
+public:
+    explicit JsonBindReader(const std::string_view json_data_) : json_data(json_data_) {}
+
+    [[nodiscard]] auto get_error_code() const { return error_code; }
+    [[nodiscard]] auto get_index() const { return index; }
+
+    template <typename T>
+    bool read(T& value);
+
+    /**
+     * Check that only whitespaces are left after the value
+     */
+    bool finish() {
+        index = json_skip_whitespaces(json_data, index);
+        return index == json_data.size() || fail(JsonTreeParseError::unexpected_node);
+    }
+};
+
+template <typename T>
+bool JsonBindReader::read(T& value) {
+    index = json_skip_whitespaces(json_data, index);
+    if (index >= json_data.size()) {
+        return fail(JsonTreeParseError::unexpected_end_of_data);
+    }
+    if constexpr (JsonIsOptional<T>::value) {
+        if (json_data[index] == 'n') {
+            value.reset();
+            return read_null();
+        }
+        return read(value.emplace());
+    } else if constexpr (std::is_same_v<T, bool>) {
+        return read_boolean(value);
+    } else if constexpr (std::is_integral_v<T> || std::is_floating_point_v<T>) {
+        return read_number(value);
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        return read_string(value);
+    } else if constexpr (JsonIsArray<T>::value) {
+        size_t count = 0;
+        return read_items([&] {
+            return count < value.size() ? read(value[count++]) : fail(JsonTreeParseError::too_many_items);
+        });
+    } else if constexpr (JsonIsVector<T>::value) {
+        value.clear();
+        return read_items([&] { return read(value.emplace_back()); });
+    } else {
+        static_assert(JsonBoundStruct<T>, "type is not bound, specialize JsonFields for it");
+        return read_object(value);
+    }
+}
+
+inline std::string_view JsonBindReader::read_literal() {
+    const auto start = index;
+    while (index < json_data.size() && json_is_alpha(json_data[index])) {
+        index++;
+    }
+    return json_data.substr(start, index - start);
+}
+
+inline bool JsonBindReader::read_boolean(bool& value) {
+    if (json_token_classes[static_cast<uint8_t>(json_data[index])] != JsonTokenClass::literal) {
+        return fail(JsonTreeParseError::value_type_mismatch);
+    }
+    const auto start = index;
+    const auto literal = read_literal();
+    if (literal == "true" || literal == "false") {
+        value = literal == "true";
+        return true;
+    }
+    index = start;
+    return fail(literal == "null" ? JsonTreeParseError::value_type_mismatch : JsonTreeParseError::unexpected_literal);
+}
+
+inline bool JsonBindReader::read_null() {
+    const auto start = index;
+    if (read_literal() != "null") {
+        index = start;
+        return fail(JsonTreeParseError::unexpected_literal);
+    }
+    return true;
+}
+
+template <typename T>
+bool JsonBindReader::read_number(T& value) {
+    if (json_token_classes[static_cast<uint8_t>(json_data[index])] != JsonTokenClass::number) {
+        return fail(JsonTreeParseError::value_type_mismatch);
+    }
+    const auto start = index;
+    bool is_double;
+    if (const auto error = json_scan_number(json_data, index, is_double); error != JsonTreeParseError::no_error) {
+        return fail(error);
+    }
+    const auto number = json_data.substr(start, index - start);
+    if (std::is_integral_v<T> && is_double) {
+        index = start;
+        return fail(JsonTreeParseError::value_type_mismatch);
+    }
+    const auto converted = std::from_chars(number.data(), number.data() + number.size(), value);
+    if (converted.ec != std::errc{} || converted.ptr != number.data() + number.size()) {
+        index = start;
+        return fail(converted.ec == std::errc::result_out_of_range ? JsonTreeParseError::number_out_of_range
+                                                                   : JsonTreeParseError::invalid_number_literal);
+    }
+    return true;
+}
+
+inline bool JsonBindReader::read_string(std::string& value) {
+    if (json_data[index] != '"') {
+        return fail(JsonTreeParseError::value_type_mismatch);
+    }
+    bool has_escapes;
+    const auto end = json_find_string_end(json_data, index + 1, has_escapes);
+    if (end >= json_data.size()) {
+        index = json_data.size();
+        return fail(JsonTreeParseError::unexpected_end_of_data);
+    }
+    const auto raw = json_data.substr(index + 1, end - index - 1);
+    if (has_escapes) {
+        value.clear();
+        const auto invalid = json_decode_string_to(raw, [&value](const char* data, const size_t size) {
+            value.append(data, size);
+        });
+        if (invalid < raw.size()) {
+            index += 1 + invalid;
+            return fail(JsonTreeParseError::invalid_escape_sequence);
+        }
+    } else {
+        value.assign(raw);
+    }
+    index = end + 1;
+    return true;
+}
+
+/**
+ * Read items of array with read_item(), index is at the opening bracket
+ */
+template <typename F>
+bool JsonBindReader::read_items(F&& read_item) {
+    if (json_data[index] != '[') {
+        return fail(JsonTreeParseError::value_type_mismatch);
+    }
+    index = json_skip_whitespaces(json_data, index + 1);
+    if (index < json_data.size() && json_data[index] == ']') {
+        ++index;
+        return true;
+    }
+    while (true) {
+        if (!read_item()) {
+            return false;
+        }
+        index = json_skip_whitespaces(json_data, index);
+        if (index >= json_data.size()) {
+            return fail(JsonTreeParseError::unexpected_end_of_data);
+        }
+        if (json_data[index] == ']') {
+            ++index;
+            return true;
+        }
+        if (json_data[index] != ',') {
+            return fail(JsonTreeParseError::missing_comma);
+        }
+        index = json_skip_whitespaces(json_data, index + 1);
+        if (index < json_data.size() && json_data[index] == ']') {
+            return fail(JsonTreeParseError::trailing_comma);
+        }
+    }
+}
+
+/**
+ * Read key and colon, keys with escape sequences are decoded
+ */
+inline bool JsonBindReader::read_key(std::string_view& name) {
+    if (json_data[index] != '"') {
+        return fail(JsonTreeParseError::key_must_be_string);
+    }
+    bool has_escapes;
+    const auto end = json_find_string_end(json_data, index + 1, has_escapes);
+    if (end >= json_data.size()) {
+        index = json_data.size();
+        return fail(JsonTreeParseError::unexpected_end_of_data);
+    }
+    name = json_data.substr(index + 1, end - index - 1);
+    if (has_escapes) {
+        key.clear();
+        const auto invalid = json_decode_string_to(name, [this](const char* data, const size_t size) {
+            key.append(data, size);
+        });
+        if (invalid < name.size()) {
+            index += 1 + invalid;
+            return fail(JsonTreeParseError::invalid_escape_sequence);
+        }
+        name = key;
+    }
+    index = json_skip_whitespaces(json_data, end + 1);
+    if (index >= json_data.size()) {
+        return fail(JsonTreeParseError::unexpected_end_of_data);
+    }
+    if (json_data[index] != ':') {
+        return fail(JsonTreeParseError::missing_colon);
+    }
+    ++index;
+    return true;
+}
+
+template <typename T>
+bool JsonBindReader::read_object(T& value) {
+    if (json_data[index] != '{') {
+        return fail(JsonTreeParseError::value_type_mismatch);
+    }
+    index = json_skip_whitespaces(json_data, index + 1);
+    if (index < json_data.size() && json_data[index] == '}') {
+        ++index;
+        return true;
+    }
+    while (true) {
+        if (index >= json_data.size()) {
+            return fail(JsonTreeParseError::unexpected_end_of_data);
+        }
+        std::string_view name;
+        if (!read_key(name)) {
+            return false;
+        }
+        if (const auto field = JsonStructBinding<T>::find(name); field != JsonStructBinding<T>::npos) {
+            if (!JsonStructBinding<T>::read_field(field, *this, value)) {
+                return false;
+            }
+        } else {
+            index = json_skip_whitespaces(json_data, index);
+            if (index >= json_data.size()) {
+                return fail(JsonTreeParseError::unexpected_end_of_data);
+            }
+            auto error = JsonTreeParseError::no_error;
+            index = json_skip_value(json_data, index, error);
+            if (error != JsonTreeParseError::no_error) {
+                return fail(error);
+            }
+        }
+        index = json_skip_whitespaces(json_data, index);
+        if (index >= json_data.size()) {
+            return fail(JsonTreeParseError::unexpected_end_of_data);
+        }
+        if (json_data[index] == '}') {
+            ++index;
+            return true;
+        }
+        if (json_data[index] != ',') {
+            return fail(JsonTreeParseError::missing_comma);
+        }
+        index = json_skip_whitespaces(json_data, index + 1);
+        if (index < json_data.size() && json_data[index] == '}') {
+            return fail(JsonTreeParseError::trailing_comma);
+        }
+    }
+}
+
+struct JsonBindResult {
+    JsonTreeParseError error_code{JsonTreeParseError::no_error};
+    size_t index{0}; // position of the error in json data
+
+    [[nodiscard]] auto valid() const { return error_code == JsonTreeParseError::no_error; }
+};
+
+/**
+ * Read json data into value, value is partially filled when there is an error
+ */
+template <typename T>
+JsonBindResult json_bind(const std::string_view json_data, T& value) {
+    if (json_skip_whitespaces(json_data, 0) == json_data.size()) {
+        return {JsonTreeParseError::empty_json_data, json_data.size()};
+    }
+    JsonBindReader reader(json_data);
+    if (reader.read(value)) {
+        reader.finish();
+    }
+    return {reader.get_error_code(), reader.get_index()};
+}
+
+
+#endif //__jsontree__jsontree_bind_hpp
@@ -0,0 +1,255 @@
+/*
+ * jsontree - JSON Parsing and library in C++20
+ * Copyright 2025 Marcin Markiewicz, marcin.kivrin@gmail.com
+ *
+ * This file is a part of jsontree project
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * Project: jsontree
+ *
+ */
+
+#ifndef __jsontree__jsontree_cache_hpp
+#define __jsontree__jsontree_cache_hpp
+
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include "jsontree.hpp"
+#include "jsontree_parser.hpp"
+
+
+/**
+ * Fast non-cryptographic 64-bit hash of json data. Four independent lanes take 32 bytes per step, so long data is
+ * hashed at memory speed. Equal hashes do not mean equal data, cache compares bytes of data on hit.
+ */
+inline uint64_t json_content_hash(const std::string_view data, const uint64_t seed = 0) {
+    constexpr uint64_t prime = 0x9E3779B97F4A7C15ull;
+    const auto mix = [](uint64_t lane, const uint64_t word) {
+        lane = (lane ^ word) * prime;
+        return lane ^ (lane >> 29);
+    };
+    const auto read = [&](const size_t offset) {
+        uint64_t word;
+        std::memcpy(&word, data.data() + offset, sizeof(word));
+        return word;
+    };
+    uint64_t lanes[4] = {seed, seed + prime, seed ^ 0xC2B2AE3D27D4EB4Full, seed - prime};
+    size_t index = 0;
+    for (; index + 32 <= data.size(); index += 32) {
+        lanes[0] = mix(lanes[0], read(index));
+        lanes[1] = mix(lanes[1], read(index + 8));
+        lanes[2] = mix(lanes[2], read(index + 16));
+        lanes[3] = mix(lanes[3], read(index + 24));
+    }
+    for (; index + 8 <= data.size(); index += 8) {
+        lanes[0] = mix(lanes[0], read(index));
+    }
+    if (index < data.size()) {
+        uint64_t tail = 0;
+        std::memcpy(&tail, data.data() + index, data.size() - index);
+        lanes[1] = mix(lanes[1], tail);
+    }
+    auto hash = data.size() * prime;
+    for (const auto lane : lanes) {
+        hash = (hash ^ lane) * prime;
+        hash = (hash << 31) | (hash >> 33);
+    }
+    // finalizer of MurmurHash3
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDull;
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB9FE1A85EC53ull;
+    return hash ^ (hash >> 33);
+}
+
+/**
+ * Parsed document which owns a copy of its json data, shared by the cache and its users. Document is immutable,
+ * numbers are decoded when parsed and key indexes are built under a lock, so it can be read from many threads.
+ */
+class JsonCachedDocument {
+    const std::string json_data; // nodes point into it
+    const uint64_t hash;
+    JsonDocument document{};
+
+public:
+    JsonCachedDocument(const std::string_view json_data_, const uint64_t hash_, JsonTreeParseOptions options)
+        : json_data(json_data_), hash(hash_) {
+        options.lazy_numbers = false;
+        JsonParser parser;
+        parser.parse(json_data, document, options);
+    }
+
+    JsonCachedDocument(const JsonCachedDocument& other) = delete;
+    JsonCachedDocument(JsonCachedDocument&& other) noexcept = delete;
+
+    [[nodiscard]] std::string_view get_json_data() const { return json_data; }
+    [[nodiscard]] auto get_hash() const { return hash; }
+    [[nodiscard]] auto& get_document() const { return document; }
+    [[nodiscard]] auto get_error_code() const { return document.get_error_code(); }
+    [[nodiscard]] auto valid() const { return document.valid(); }
+    [[nodiscard]] auto get_root() const { return document.get_root(); }
+
+    /**
+     * Memory counted by the cache: json data, nodes, decoded strings and key indexes. Indexes are built by lookups
+     * after the document is cached, so their bound is counted from the start and the size does not change.
+     */
+    [[nodiscard]] size_t get_size() const {
+        return json_data.size() + document.get_nodes().size() * sizeof(JsonNode) +
+               document.get_strings().capacity() + document.get_key_indexes_size();
+    }
+};
+
+struct JsonParseCacheOptions {
+    size_t max_bytes{64 * 1024 * 1024}; // cached documents, see JsonCachedDocument::get_size()
+    size_t max_entries{4096};
+    JsonTreeParseOptions parse_options{}; // lazy_numbers is ignored
+};
+
+struct JsonParseCacheMetrics {
+    uint64_t hits{0};
+    uint64_t misses{0};
+    uint64_t evictions{0};
+    size_t entries{0};
+    size_t bytes{0};
+};
+
+/**
+ * Bounded LRU cache of parsed documents, keyed by hash of json data.
+ *
+ * Hit returns shared document without parsing, after comparing length and bytes of json data. Miss parses a copy
+ * of json data outside of the lock, so threads parse different documents at once; two threads which miss the same
+ * data parse it both and the first one is kept. Documents which are not valid are returned, but not cached.
+ * Least recently used documents are evicted when the cache exceeds max_bytes or max_entries, documents bigger
+ * than max_bytes are not cached. Evicted documents live as long as someone holds them.
+ */
+class JsonParseCache {
+public:
+    using Document = std::shared_ptr<const JsonCachedDocument>;
+
+private:
+    using Entries = std::list<Document>; // most recently used first
+
+    JsonParseCacheOptions options;
+    mutable std::mutex mutex{};
+    Entries entries{};
+    std::unordered_map<uint64_t, Entries::iterator> index{};
+    size_t bytes{0};
+    std::atomic<uint64_t> hits{0};
+    std::atomic<uint64_t> misses{0};
+    std::atomic<uint64_t> evictions{0};
+
+    Document find(uint64_t hash);
+    Document add(Document document);
+    void evict(size_t needed_bytes);
+
+public:
+    explicit JsonParseCache(const JsonParseCacheOptions& options_ = {}) : options(options_) {}
+
+    JsonParseCache(const JsonParseCache& other) = delete;
+    JsonParseCache(JsonParseCache&& other) noexcept = delete;
+
+    /**
+     * Cached document of json data, parsed on miss
+     */
+    Document parse(std::string_view json_data);
+
+    void clear();
+    [[nodiscard]] JsonParseCacheMetrics get_metrics() const;
+};
+
+inline JsonParseCache::Document JsonParseCache::parse(const std::string_view json_data) {
+    const auto hash = json_content_hash(json_data);
+    if (auto document = find(hash)) {
+        // bytes are compared outside of the lock, document can not change
+        if (document->get_json_data() == json_data) {
+            hits.fetch_add(1, std::memory_order_relaxed);
+            return document;
+        }
+    }
+    misses.fetch_add(1, std::memory_order_relaxed);
+    auto document = std::make_shared<const JsonCachedDocument>(json_data, hash, options.parse_options);
+    if (!document->valid() || document->get_size() > options.max_bytes || options.max_entries == 0) {
+        return document;
+    }
+    return add(std::move(document));
+}
+
+inline JsonParseCache::Document JsonParseCache::find(const uint64_t hash) {
+    const std::lock_guard lock(mutex);
+    const auto found = index.find(hash);
+    if (found == index.end()) {
+        return nullptr;
+    }
+    entries.splice(entries.begin(), entries, found->second);
+    return *found->second;
+}
+
+/**
+ * Add parsed document, or return document of the same data added meanwhile by other thread. Document with the
+ * same hash and other data (collision) replaces the cached one.
+ */
+inline JsonParseCache::Document JsonParseCache::add(Document document) {
+    const std::lock_guard lock(mutex);
+    if (const auto found = index.find(document->get_hash()); found != index.end()) {
+        const auto cached = *found->second;
+        if (cached->get_json_data() == document->get_json_data()) {
+            entries.splice(entries.begin(), entries, found->second);
+            return cached;
+        }
+        bytes -= cached->get_size();
+        entries.erase(found->second);
+        index.erase(found);
+        evictions.fetch_add(1, std::memory_order_relaxed);
+    }
+    evict(document->get_size());
+    bytes += document->get_size();
+    entries.push_front(document);
+    index.emplace(document->get_hash(), entries.begin());
+    return document;
+}
+
+inline void JsonParseCache::evict(const size_t needed_bytes) {
+    while (!entries.empty() && (bytes + needed_bytes > options.max_bytes || entries.size() >= options.max_entries)) {
+        const auto& last = entries.back();
+        bytes -= last->get_size();
+        index.erase(last->get_hash());
+        entries.pop_back();
+        evictions.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+inline void JsonParseCache::clear() {
+    const std::lock_guard lock(mutex);
+    index.clear();
+    entries.clear();
+    bytes = 0;
+}
+
+inline JsonParseCacheMetrics JsonParseCache::get_metrics() const {
+    const std::lock_guard lock(mutex);
+    return {hits.load(std::memory_order_relaxed), misses.load(std::memory_order_relaxed),
+            evictions.load(std::memory_order_relaxed), entries.size(), bytes};
+}
+
+
+#endif //__jsontree__jsontree_cache_hpp
@@ -0,0 +1,210 @@
+/*
+ * jsontree - JSON Parsing and library in C++20
+ * Copyright 2025 Marcin Markiewicz, marcin.kivrin@gmail.com
+ *
+ * This file is a part of jsontree project
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * Project: jsontree
+ *
+ */
+
+#ifndef __jsontree__jsontree_chars_hpp
+#define __jsontree__jsontree_chars_hpp
+
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+
+/**
+ * Character classification tables. Unlike <cctype> functions they do not depend on locale, are evaluated at
+ * compile time and follow JSON rules: whitespace is only space, tab, line feed and carriage return.
+ *
+ * JsonTokenClass is class of token which starts with given character, parser selects rule with single lookup.
+ */
+enum class JsonTokenClass : uint8_t {
+    unknown,
+    whitespace,
+    object_start,
+    object_end,
+    array_start,
+    array_end,
+    colon,
+    comma,
+    string,
+    number,
+    literal,
+};
+
+constexpr std::array<JsonTokenClass, 256> make_json_token_classes() {
+    std::array<JsonTokenClass, 256> classes{};
+    for (const auto c : {' ', '\t', '\n', '\r'}) {
+        classes[static_cast<uint8_t>(c)] = JsonTokenClass::whitespace;
+    }
+    classes['{'] = JsonTokenClass::object_start;
+    classes['}'] = JsonTokenClass::object_end;
+    classes['['] = JsonTokenClass::array_start;
+    classes[']'] = JsonTokenClass::array_end;
+    classes[':'] = JsonTokenClass::colon;
+    classes[','] = JsonTokenClass::comma;
+    classes['"'] = JsonTokenClass::string;
+    classes['-'] = JsonTokenClass::number;
+    for (auto c = '0'; c <= '9'; ++c) {
+        classes[static_cast<uint8_t>(c)] = JsonTokenClass::number;
+    }
+    for (auto c = 'a'; c <= 'z'; ++c) {
+        classes[static_cast<uint8_t>(c)] = JsonTokenClass::literal;
+        classes[static_cast<uint8_t>(c - 'a' + 'A')] = JsonTokenClass::literal;
+    }
+    return classes;
+}
+
+constexpr auto json_token_classes = make_json_token_classes();
+
+constexpr uint8_t json_char_whitespace = 0x01;
+constexpr uint8_t json_char_digit = 0x02;
+constexpr uint8_t json_char_alpha = 0x04;
+constexpr uint8_t json_char_number = 0x08; // any character of number literal: digits, sign, dot and exponent
+
+constexpr std::array<uint8_t, 256> make_json_char_flags() {
+    std::array<uint8_t, 256> flags{};
+    for (const auto c : {' ', '\t', '\n', '\r'}) {
+        flags[static_cast<uint8_t>(c)] |= json_char_whitespace;
+    }
+    for (auto c = '0'; c <= '9'; ++c) {
+        flags[static_cast<uint8_t>(c)] |= json_char_digit | json_char_number;
+    }
+    for (auto c = 'a'; c <= 'z'; ++c) {
+        flags[static_cast<uint8_t>(c)] |= json_char_alpha;
+        flags[static_cast<uint8_t>(c - 'a' + 'A')] |= json_char_alpha;
+    }
+    for (const auto c : {'-', '+', '.', 'e', 'E'}) {
+        flags[static_cast<uint8_t>(c)] |= json_char_number;
+    }
+    return flags;
+}
+
+constexpr auto json_char_flags = make_json_char_flags();
+
+constexpr bool json_is_whitespace(const char c) {
+    return json_char_flags[static_cast<uint8_t>(c)] & json_char_whitespace;
+}
+
+constexpr bool json_is_digit(const char c) {
+    return json_char_flags[static_cast<uint8_t>(c)] & json_char_digit;
+}
+
+constexpr bool json_is_alpha(const char c) {
+    return json_char_flags[static_cast<uint8_t>(c)] & json_char_alpha;
+}
+
+constexpr bool json_is_number_char(const char c) {
+    return json_char_flags[static_cast<uint8_t>(c)] & json_char_number;
+}
+
+constexpr int json_hex_digit_value(const char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+/**
+ * Number literal which can be decoded later without any error: well formed for std::from_chars, an integer
+ * which fits in int (at most 9 digits) or a double which can not overflow (short mantissa, exponent below 100).
+ */
+constexpr bool json_is_number_lazy_decodable(const std::string_view value) {
+    size_t index = value.starts_with('-') ? 1 : 0;
+    const auto digits_start = index;
+    while (index < value.size() && json_is_digit(value[index])) {
+        ++index;
+    }
+    auto digits = index - digits_start;
+    if (index == value.size()) {
+        return digits > 0 && digits <= 9;
+    }
+    if (value[index] == '.') {
+        const auto fraction_start = ++index;
+        while (index < value.size() && json_is_digit(value[index])) {
+            ++index;
+        }
+        digits += index - fraction_start;
+    }
+    if (digits == 0 || value.size() > 64) {
+        return false;
+    }
+    if (index < value.size() && (value[index] == 'e' || value[index] == 'E')) {
+        ++index;
+        if (index < value.size() && (value[index] == '+' || value[index] == '-')) {
+            ++index;
+        }
+        const auto exponent_start = index;
+        while (index < value.size() && json_is_digit(value[index])) {
+            ++index;
+        }
+        if (index == exponent_start || index - exponent_start > 2) {
+            return false;
+        }
+    }
+    return index == value.size();
+}
+
+/**
+ * Number literal in strict json grammar: no leading zeros, digits on both sides of the dot and in the exponent.
+ */
+constexpr bool json_is_number_strict(const std::string_view value) {
+    size_t index = value.starts_with('-') ? 1 : 0;
+    if (index == value.size() || !json_is_digit(value[index])) {
+        return false;
+    }
+    if (value[index++] != '0') {
+        while (index < value.size() && json_is_digit(value[index])) {
+            ++index;
+        }
+    }
+    if (index < value.size() && value[index] == '.') {
+        const auto fraction_start = ++index;
+        while (index < value.size() && json_is_digit(value[index])) {
+            ++index;
+        }
+        if (index == fraction_start) {
+            return false;
+        }
+    }
+    if (index < value.size() && (value[index] == 'e' || value[index] == 'E')) {
+        ++index;
+        if (index < value.size() && (value[index] == '+' || value[index] == '-')) {
+            ++index;
+        }
+        const auto exponent_start = index;
+        while (index < value.size() && json_is_digit(value[index])) {
+            ++index;
+        }
+        if (index == exponent_start) {
+            return false;
+        }
+    }
+    return index == value.size();
+}
+
+#endif //__jsontree__jsontree_chars_hpp
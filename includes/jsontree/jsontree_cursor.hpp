@@ -0,0 +1,400 @@
+/*
+ * jsontree - JSON Parsing and library in C++20
+ * Copyright 2025 Marcin Markiewicz, marcin.kivrin@gmail.com
+ *
+ * This file is a part of jsontree project
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * Project: jsontree
+ *
+ */
+
+#ifndef __jsontree__jsontree_cursor_hpp
+#define __jsontree__jsontree_cursor_hpp
+
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "jsontree.hpp"
+
+
+/**
+ * Stack of open brackets of skipped containers, one bit per level: set for object, clear for array. First 256
+ * levels are kept inline, deeper documents spill to heap.
+ */
+class JsonSkipStack {
+    static constexpr size_t inline_words = 4;
+    uint64_t inline_bits[inline_words]{};
+    std::vector<uint64_t> spilled_bits{};
+    size_t depth{0};
+
+    uint64_t& word(const size_t level) {
+        return level < inline_words * 64 ? inline_bits[level / 64] : spilled_bits[level / 64 - inline_words];
+    }
+
+public:
+    [[nodiscard]] auto get_depth() const { return depth; }
+
+    void push(const bool object) {
+        if (depth >= inline_words * 64 && depth % 64 == 0) {
+            spilled_bits.push_back(0);
+        }
+        const auto bit = uint64_t{1} << (depth % 64);
+        auto& bits = word(depth++);
+        bits = object ? bits | bit : bits & ~bit;
+    }
+
+    /**
+     * Close the innermost container, false if it was opened with the other bracket type
+     */
+    bool pop(const bool object) {
+        --depth;
+        return ((word(depth) >> (depth % 64)) & 1) == static_cast<uint64_t>(object);
+    }
+};
+
+/**
+ * Skip scalar value at start, returns index after the value. Numbers and literals are converted the same way as by
+ * the parser (numbers which can be decoded lazily only by their text), so they report the same error codes.
+ */
+inline size_t json_skip_scalar(const std::string_view json_data, const size_t start, JsonTreeParseError& error) {
+    auto i = start;
+    switch (json_token_classes[static_cast<uint8_t>(json_data[i])]) {
+    case JsonTokenClass::string:
+        i = json_find_string_end(json_data, i + 1);
+        if (i >= json_data.size()) {
+            error = JsonTreeParseError::unexpected_end_of_data;
+            return i;
+        }
+        return i + 1;
+    case JsonTokenClass::number: {
+        bool is_double;
+        error = json_scan_number(json_data, i, is_double);
+        if (error == JsonTreeParseError::no_error) {
+            JsonNode node;
+            error = json_convert_number(json_data.substr(start, i - start), is_double, true, node);
+        }
+        return i;
+    }
+    case JsonTokenClass::literal: {
+        while (i < json_data.size() && json_is_alpha(json_data[i])) {
+            i++;
+        }
+        JsonNode node;
+        error = json_convert_literal(json_data.substr(start, i - start), node);
+        return error == JsonTreeParseError::no_error ? i : start;
+    }
+    case JsonTokenClass::unknown:
+        error = JsonTreeParseError::unknown_token;
+        return i;
+    default:
+        error = JsonTreeParseError::unexpected_node;
+        return i;
+    }
+}
+
+/**
+ * Skip value at start, returns index after the value. Inside containers every token is checked: brackets must
+ * pair with the same type, strings must be closed, numbers and literals are checked as by json_skip_scalar().
+ * Separators are not: missing or extra commas and colons in skipped containers are not reported.
+ */
+inline size_t json_skip_value(const std::string_view json_data, const size_t start, JsonTreeParseError& error) {
+    const auto token_class = json_token_classes[static_cast<uint8_t>(json_data[start])];
+    if (token_class != JsonTokenClass::object_start && token_class != JsonTokenClass::array_start) {
+        return json_skip_scalar(json_data, start, error);
+    }
+    JsonSkipStack stack;
+    for (auto i = start; i < json_data.size();) {
+        switch (json_token_classes[static_cast<uint8_t>(json_data[i])]) {
+        case JsonTokenClass::object_start:
+        case JsonTokenClass::array_start:
+            stack.push(json_data[i] == '{');
+            ++i;
+            break;
+        case JsonTokenClass::object_end:
+        case JsonTokenClass::array_end:
+            if (!stack.pop(json_data[i] == '}')) {
+                error = json_data[i] == '}' ? JsonTreeParseError::end_of_object_mismatch
+                                            : JsonTreeParseError::end_of_array_mismatch;
+                return i;
+            }
+            if (stack.get_depth() == 0) {
+                return i + 1;
+            }
+            ++i;
+            break;
+        case JsonTokenClass::comma:
+        case JsonTokenClass::colon:
+        case JsonTokenClass::whitespace:
+            ++i;
+            break;
+        default:
+            i = json_skip_scalar(json_data, i, error);
+            if (error != JsonTreeParseError::no_error) {
+                return i;
+            }
+            break;
+        }
+    }
+    error = JsonTreeParseError::unexpected_end_of_data;
+    return json_data.size();
+}
+
+
+/**
+ * Position of one value in json data, used to read a few values without building a tree.
+ *
+ * Cursor walks json data forward only when asked: find() and at() scan members of one object or array and skip
+ * values which are not needed, scalars are converted only by get_node(). Cursor is two words and an error code,
+ * nothing is allocated unless skipped containers are nested deeper than 256 levels. Skipped values are checked token by
+ * token (see json_skip_value()), values on the way to the requested one are checked the same way as by JsonTree and
+ * report the same error codes.
+ *
+ * Cursor which points to nothing (missing key, index out of range, wrong type) is not valid and has no error,
+ * cursor which met malformed json is not valid and has error code and index. Both propagate through find()/at().
+ */
+class JsonCursor {
+    std::string_view json_data{};
+    size_t index{0};
+    JsonTreeParseError error_code{JsonTreeParseError::no_error};
+    bool found{false};
+
+    friend class JsonDocumentView;
+
+    JsonCursor(const std::string_view json_data_, const size_t index_)
+        : json_data(json_data_), index(index_), found(true) {}
+
+    JsonCursor(const std::string_view json_data_, const size_t index_, const JsonTreeParseError error_code_)
+        : json_data(json_data_), index(index_), error_code(error_code_) {}
+
+    [[nodiscard]] JsonTokenClass get_token_class() const {
+        return found && error_code == JsonTreeParseError::no_error
+            ? json_token_classes[static_cast<uint8_t>(json_data[index])]
+            : JsonTokenClass::unknown;
+    }
+
+    template <typename F>
+    JsonCursor walk(bool object, F&& f) const;
+
+public:
+    JsonCursor() = default;
+
+    [[nodiscard]] auto valid() const { return found && error_code == JsonTreeParseError::no_error; }
+    [[nodiscard]] auto get_error_code() const { return error_code; }
+    [[nodiscard]] auto get_index() const { return index; }
+    [[nodiscard]] auto get_json_data() const { return json_data; }
+    [[nodiscard]] auto is_object() const { return get_token_class() == JsonTokenClass::object_start; }
+    [[nodiscard]] auto is_array() const { return get_token_class() == JsonTokenClass::array_start; }
+    [[nodiscard]] auto is_string() const { return get_token_class() == JsonTokenClass::string; }
+    [[nodiscard]] auto is_number() const { return get_token_class() == JsonTokenClass::number; }
+    [[nodiscard]] auto is_boolean() const { return valid() && (json_data[index] == 't' || json_data[index] == 'f'); }
+    [[nodiscard]] auto is_null() const { return valid() && json_data[index] == 'n'; }
+
+    /**
+     * Value of the first key with given name in object. Keys with escape sequences are compared decoded.
+     */
+    [[nodiscard]] JsonCursor find(std::string_view key) const {
+        return walk(true, [key](const std::string_view name, const bool escapes, const JsonCursor&) {
+            return escapes ? json_decoded_string_equals(name, key) : name == key;
+        });
+    }
+
+    /**
+     * Item of array at given position
+     */
+    [[nodiscard]] JsonCursor at(size_t position) const {
+        return walk(false, [&position](std::string_view, bool, const JsonCursor&) { return position-- == 0; });
+    }
+
+    /**
+     * Call f(std::string_view key, const JsonCursor& value) for members of object, key is raw text from json data.
+     * Returns error met on the way.
+     */
+    template <typename F>
+    JsonTreeParseError for_each_member(F&& f) const {
+        return walk(true, [&f](const std::string_view key, bool, const JsonCursor& value) {
+            f(key, value);
+            return false;
+        }).get_error_code();
+    }
+
+    /**
+     * Call f(const JsonCursor& item) for items of array. Returns error met on the way.
+     */
+    template <typename F>
+    JsonTreeParseError for_each_item(F&& f) const {
+        return walk(false, [&f](std::string_view, bool, const JsonCursor& item) {
+            f(item);
+            return false;
+        }).get_error_code();
+    }
+
+    /**
+     * Raw text of value, empty if cursor is not valid or value is not complete
+     */
+    [[nodiscard]] std::string_view get_raw() const;
+
+    /**
+     * Convert scalar value to node. Strings keep raw text and has_escapes() set when they contain escape
+     * sequences, json_decode_string() decodes them. Containers are reported as unexpected_node.
+     */
+    JsonTreeParseError get_node(JsonNode& node, bool lazy_numbers = false) const;
+};
+
+/**
+ * Entry point of on-demand reading of json data, data must outlive the view and all its cursors
+ */
+class JsonDocumentView {
+    std::string_view json_data;
+
+public:
+    explicit JsonDocumentView(const std::string_view json_data_) : json_data(json_data_) {}
+
+    [[nodiscard]] auto get_json_data() const { return json_data; }
+
+    [[nodiscard]] JsonCursor get_root() const {
+        const auto index = json_skip_whitespaces(json_data, 0);
+        if (index == json_data.size()) {
+            return {json_data, index, JsonTreeParseError::empty_json_data};
+        }
+        return {json_data, index};
+    }
+
+    [[nodiscard]] JsonCursor find(const std::string_view key) const { return get_root().find(key); }
+    [[nodiscard]] JsonCursor at(const size_t position) const { return get_root().at(position); }
+};
+
+/**
+ * Walk over members of object or items of array, f(key, key_escapes, value) returns true to stop on value.
+ * Returns the value where f stopped, cursor to nothing when walk reached the end, or cursor with error.
+ */
+template <typename F>
+JsonCursor JsonCursor::walk(const bool object, F&& f) const {
+    if (!valid()) {
+        return *this;
+    }
+    const auto size = json_data.size();
+    const auto open = object ? '{' : '[';
+    const auto close = object ? '}' : ']';
+    if (json_data[index] != open) {
+        return {};
+    }
+    auto i = json_skip_whitespaces(json_data, index + 1);
+    if (i < size && json_data[i] == close) {
+        return {};
+    }
+    while (true) {
+        std::string_view key{};
+        bool key_escapes = false;
+        if (i >= size) {
+            return {json_data, i, JsonTreeParseError::unexpected_end_of_data};
+        }
+        if (json_data[i] == close) {
+            return {json_data, i, JsonTreeParseError::trailing_comma};
+        }
+        if (object) {
+            if (json_data[i] != '"') {
+                return {json_data, i, JsonTreeParseError::key_must_be_string};
+            }
+            const auto key_end = json_find_string_end(json_data, i + 1, key_escapes);
+            if (key_end >= size) {
+                return {json_data, size, JsonTreeParseError::unexpected_end_of_data};
+            }
+            key = json_data.substr(i + 1, key_end - i - 1);
+            i = json_skip_whitespaces(json_data, key_end + 1);
+            if (i >= size) {
+                return {json_data, i, JsonTreeParseError::unexpected_end_of_data};
+            }
+            if (json_data[i] != ':') {
+                return {json_data, i, JsonTreeParseError::missing_colon};
+            }
+            i = json_skip_whitespaces(json_data, i + 1);
+            if (i >= size) {
+                return {json_data, i, JsonTreeParseError::unexpected_end_of_data};
+            }
+        }
+        const JsonCursor value(json_data, i);
+        if (f(key, key_escapes, value)) {
+            return value;
+        }
+        auto error = JsonTreeParseError::no_error;
+        i = json_skip_value(json_data, i, error);
+        if (error != JsonTreeParseError::no_error) {
+            return {json_data, i, error};
+        }
+        i = json_skip_whitespaces(json_data, i);
+        if (i >= size) {
+            return {json_data, i, JsonTreeParseError::unexpected_end_of_data};
+        }
+        if (json_data[i] == close) {
+            return {};
+        }
+        if (json_data[i] != ',') {
+            return {json_data, i, JsonTreeParseError::missing_comma};
+        }
+        i = json_skip_whitespaces(json_data, i + 1);
+    }
+}
+
+inline std::string_view JsonCursor::get_raw() const {
+    if (!valid()) {
+        return {};
+    }
+    auto error = JsonTreeParseError::no_error;
+    const auto end = json_skip_value(json_data, index, error);
+    return error == JsonTreeParseError::no_error ? json_data.substr(index, end - index) : std::string_view{};
+}
+
+inline JsonTreeParseError JsonCursor::get_node(JsonNode& node, const bool lazy_numbers) const {
+    if (!valid()) {
+        return found ? error_code : JsonTreeParseError::unexpected_node;
+    }
+    auto i = index;
+    switch (get_token_class()) {
+    case JsonTokenClass::string: {
+        bool has_escapes;
+        const auto end = json_find_string_end(json_data, i + 1, has_escapes);
+        if (end >= json_data.size()) {
+            return JsonTreeParseError::unexpected_end_of_data;
+        }
+        node = JsonNode(json_data.substr(i + 1, end - i - 1));
+        if (has_escapes) {
+            node.flags |= JsonNode::escapes_flag;
+        }
+        return JsonTreeParseError::no_error;
+    }
+    case JsonTokenClass::number: {
+        bool is_double;
+        const auto error = json_scan_number(json_data, i, is_double);
+        if (error != JsonTreeParseError::no_error) {
+            return error;
+        }
+        return json_convert_number(json_data.substr(index, i - index), is_double, lazy_numbers, node);
+    }
+    case JsonTokenClass::literal:
+        while (i < json_data.size() && json_is_alpha(json_data[i])) {
+            i++;
+        }
+        return json_convert_literal(json_data.substr(index, i - index), node);
+    case JsonTokenClass::unknown:
+        return JsonTreeParseError::unknown_token;
+    default:
+        return JsonTreeParseError::unexpected_node;
+    }
+}
+
+
+#endif //__jsontree__jsontree_cursor_hpp
@@ -0,0 +1,379 @@
+/*
+ * jsontree - JSON Parsing and library in C++20
+ * Copyright 2025 Marcin Markiewicz, marcin.kivrin@gmail.com
+ *
+ * This file is a part of jsontree project
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * Project: jsontree
+ *
+ */
+
+#ifndef __jsontree__jsontree_edit_hpp
+#define __jsontree__jsontree_edit_hpp
+
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "jsontree.hpp"
+#include "jsontree_structural.hpp"
+#include "jsontree_writer.hpp"
+
+
+/**
+ * Edits of a parsed tree, written back as json text.
+ *
+ * Nodes of the tree are not changed, edits are kept aside: new values as json text, erased keys and array items,
+ * keys added to objects. Every edit marks the containers on the way from root as dirty. Writer copies subtrees
+ * which are not dirty verbatim from json data, one memcpy each, and writes only dirty containers item by item,
+ * so the cost of writing depends on the size of json data and the number of edits, not on the number of nodes.
+ * Children of all dirty containers are found by one SIMD scan of the brackets and commas of json data, before
+ * writing: brackets are matched with nodes only inside dirty containers, clean subtrees are only counted.
+ *
+ * Edited values and dirty containers are written minified, untouched subtrees keep formatting of json data. Tree
+ * and json data must outlive the editor. Trees parsed from chunks have no json data, they are written from nodes.
+ */
+class JsonEditor {
+    struct Edit {
+        std::string json_text{}; // new value, empty when only erased
+        bool erased{false};
+    };
+
+    struct Member {
+        std::string key; // json text of the key, with quotes
+        std::string json_text;
+    };
+
+    std::string_view json_data;
+    const JsonNode* root;
+    std::unordered_map<const JsonNode*, Edit> edits{};
+    std::unordered_map<const JsonNode*, std::vector<Member>> inserted{}; // keys added to objects
+    std::unordered_set<const JsonNode*> dirty_nodes{};
+
+    using Spans = std::unordered_map<const JsonNode*, std::vector<size_t>>; // commas of dirty containers
+
+    static std::string key_json_text(const std::string_view key) {
+        JsonWriter writer;
+        writer.write_string(key);
+        return std::string(writer.view());
+    }
+
+    [[nodiscard]] bool contains(const JsonNode* node) const {
+        return node != nullptr && root != nullptr && node >= root && node < root + root->get_subtree_size();
+    }
+
+    const JsonNode* mark_dirty(const JsonNode* node);
+    void find_spans(std::string_view text, Spans& spans) const;
+    bool write_node(JsonWriter& writer, const JsonNode* node, std::string_view text, const Spans& spans) const;
+    bool write_container(JsonWriter& writer, const JsonNode* node, std::string_view text, const Spans& spans) const;
+
+public:
+    JsonEditor(const std::string_view json_data_, const JsonNode* root_) : json_data(json_data_), root(root_) {}
+
+    explicit JsonEditor(const JsonTree& tree)
+        : json_data(tree.get_json_data()), root(tree.valid() ? tree.get_root() : nullptr) {}
+
+    /**
+     * Replace value of node (or value of key node) with scalar value, e.g. set_value(node, JsonNode(12))
+     */
+    bool set_value(const JsonNode* node, const JsonNode& value) { return set_json(node, json_write(&value)); }
+
+    /**
+     * Replace value of node (or value of key node) with json text, which is not checked
+     */
+    bool set_json(const JsonNode* node, std::string_view json_text);
+
+    /**
+     * Add key at the end of object, value of key which is already there is replaced
+     */
+    bool insert(const JsonNode* object, const std::string_view key, const JsonNode& value) {
+        return insert_json(object, key, json_write(&value));
+    }
+
+    bool insert_json(const JsonNode* object, std::string_view key, std::string_view json_text);
+
+    /**
+     * Erase key with its value (node is key or value of key) or array item
+     */
+    bool erase(const JsonNode* node);
+    bool erase(const JsonNode* object, std::string_view key);
+
+    /**
+     * Forget all edits
+     */
+    void clear() {
+        edits.clear();
+        inserted.clear();
+        dirty_nodes.clear();
+    }
+
+    [[nodiscard]] bool dirty(const JsonNode* node) const { return dirty_nodes.contains(node); }
+    [[nodiscard]] auto empty() const { return dirty_nodes.empty(); }
+
+    /**
+     * Append edited tree to writer
+     */
+    bool write(JsonWriter& writer) const;
+};
+
+/**
+ * Mark containers from root to node as dirty, returns parent of node, nullptr for root
+ */
+inline const JsonNode* JsonEditor::mark_dirty(const JsonNode* node) {
+    const JsonNode* parent = nullptr;
+    auto container = root;
+    while (container != node) {
+        dirty_nodes.insert(container);
+        parent = container;
+        auto child = container + 1;
+        while (child->get_next_sibling() <= node) {
+            child = child->get_next_sibling();
+        }
+        container = child;
+    }
+    return parent;
+}
+
+inline bool JsonEditor::set_json(const JsonNode* node, const std::string_view json_text) {
+    if (!contains(node) || json_text.empty()) {
+        return false;
+    }
+    if (node->is_key()) {
+        node = node->get_key_value_node();
+    }
+    mark_dirty(node);
+    auto& edit = edits[node];
+    edit.json_text = json_text;
+    edit.erased = false;
+    return true;
+}
+
+inline bool JsonEditor::insert_json(const JsonNode* object, const std::string_view key,
+                                    const std::string_view json_text) {
+    if (!contains(object) || !object->is_object() || json_text.empty()) {
+        return false;
+    }
+    if (const auto key_node = object->find(key)) {
+        edits[key_node].erased = false;
+        return set_json(key_node, json_text);
+    }
+    mark_dirty(object);
+    dirty_nodes.insert(object);
+    auto key_text = key_json_text(key);
+    auto& members = inserted[object];
+    const auto member = std::find_if(members.begin(), members.end(), [&](auto& m) { return m.key == key_text; });
+    if (member != members.end()) {
+        member->json_text = json_text;
+    } else {
+        members.push_back({std::move(key_text), std::string(json_text)});
+    }
+    return true;
+}
+
+inline bool JsonEditor::erase(const JsonNode* node) {
+    if (!contains(node) || node == root) {
+        return false;
+    }
+    const auto parent = mark_dirty(node);
+    if (parent->is_key()) {
+        node = parent; // value of key, key is erased with it
+    }
+    edits[node].erased = true;
+    return true;
+}
+
+inline bool JsonEditor::erase(const JsonNode* object, const std::string_view key) {
+    if (!contains(object) || !object->is_object()) {
+        return false;
+    }
+    if (const auto key_node = object->find(key)) {
+        return erase(key_node);
+    }
+    const auto members = inserted.find(object);
+    if (members == inserted.end()) {
+        return false;
+    }
+    const auto key_text = key_json_text(key);
+    return std::erase_if(members->second, [&](auto& m) { return m.key == key_text; }) > 0;
+}
+
+inline bool JsonEditor::write(JsonWriter& writer) const {
+    if (root == nullptr) {
+        return false;
+    }
+    // json data ends with the closing bracket of root, followed by whitespaces only
+    const auto begin = json_skip_whitespaces(json_data, 0);
+    auto end = json_data.size();
+    while (end > begin && json_is_whitespace(json_data[end - 1])) {
+        --end;
+    }
+    const auto text = json_data.substr(begin, end - begin);
+    Spans spans;
+    find_spans(text, spans);
+    return write_node(writer, root, text, spans);
+}
+
+/**
+ * Positions of commas of every dirty container in json data, text is json data of root
+ */
+inline void JsonEditor::find_spans(const std::string_view text, Spans& spans) const {
+    struct Frame {
+        const JsonNode* node;
+        const JsonNode* child; // child which is written at the current position
+        uint32_t child_index;
+        std::vector<size_t>* commas;
+    };
+    if (text.empty() || !dirty(root)) {
+        return;
+    }
+    std::vector<Frame> frames;
+    size_t clean_depth = 0; // depth of brackets in clean subtree
+    const auto offset = static_cast<size_t>(text.data() - json_data.data());
+    json_visit_operators(text, [&](const size_t position) {
+        const auto c = text[position];
+        if (c == ':') {
+            return true;
+        }
+        if (clean_depth == 0 && frames.empty() && (position > 0 || (c != '{' && c != '['))) {
+            return false; // json data does not match the tree
+        }
+        if (c == ',') {
+            if (clean_depth == 0) {
+                auto& frame = frames.back();
+                frame.commas->push_back(offset + position);
+                if (++frame.child_index < frame.node->get_children_count()) {
+                    frame.child = frame.child->get_next_sibling();
+                }
+            }
+            return true;
+        }
+        if (c == ']' || c == '}') {
+            if (clean_depth > 0) {
+                --clean_depth;
+                return true;
+            }
+            frames.pop_back();
+            return !frames.empty();
+        }
+        // opening bracket belongs to root or to the current child of dirty container
+        auto node = root;
+        if (!frames.empty()) {
+            const auto& frame = frames.back();
+            node = frame.child_index < frame.node->get_children_count() ? frame.child : nullptr;
+            if (node != nullptr && node->is_key()) {
+                node = node->get_key_value_node();
+            }
+        }
+        if (clean_depth > 0 || node == nullptr || !dirty(node) || node->is_object() != (c == '{')) {
+            ++clean_depth;
+        } else {
+            frames.push_back({node, node + 1, 0, &spans[node]});
+        }
+        return true;
+    });
+}
+
+/**
+ * Write node whose value is text of json data, text is empty when json data is not known
+ */
+inline bool JsonEditor::write_node(JsonWriter& writer, const JsonNode* node, const std::string_view text,
+                                   const Spans& spans) const {
+    if (const auto edit = edits.find(node); edit != edits.end() && !edit->second.json_text.empty()) {
+        return writer.write_raw(edit->second.json_text);
+    }
+    if (!dirty(node)) {
+        return text.empty() ? writer.write(node) : writer.write_raw(text);
+    }
+    return write_container(writer, node, text, spans);
+}
+
+inline bool JsonEditor::write_container(JsonWriter& writer, const JsonNode* node, const std::string_view text,
+                                        const Spans& spans) const {
+    // spans of children are between brackets and commas of the container, positions of commas are in json data
+    const auto container_spans = text.empty() ? spans.end() : spans.find(node);
+    const auto spans_known =
+        container_spans != spans.end() && container_spans->second.size() + 1 == node->get_children_count();
+    const auto offset = spans_known ? static_cast<size_t>(text.data() - json_data.data()) : 0;
+    bool first = true;
+    const auto separator = [&] { return std::exchange(first, false) || writer.write_raw(","); };
+    if (!writer.write_raw(node->is_object() ? "{" : "[")) {
+        return false;
+    }
+    auto child = node + 1;
+    for (uint32_t i = 0; i < node->get_children_count(); ++i, child = child->get_next_sibling()) {
+        std::string_view child_text{};
+        if (spans_known) {
+            const auto& commas = container_spans->second;
+            const auto begin = i == 0 ? 1 : commas[i - 1] + 1 - offset;
+            const auto end = i + 1 < node->get_children_count() ? commas[i] - offset : text.size() - 1;
+            child_text = text.substr(begin, end - begin);
+            const auto first_byte = json_skip_whitespaces(child_text, 0);
+            auto last_byte = child_text.size();
+            while (last_byte > first_byte && json_is_whitespace(child_text[last_byte - 1])) {
+                --last_byte;
+            }
+            child_text = child_text.substr(first_byte, last_byte - first_byte);
+        }
+        if (const auto edit = edits.find(child); edit != edits.end() && edit->second.erased) {
+            continue;
+        }
+        if (!separator()) {
+            return false;
+        }
+        if (!child->is_key()) {
+            if (!write_node(writer, child, child_text, spans)) {
+                return false;
+            }
+            continue;
+        }
+        // key text is copied as it is, value follows the colon
+        std::string_view value_text{};
+        if (spans_known) {
+            const auto key_end = json_find_string_end(child_text, 1) + 1;
+            const auto colon = json_skip_whitespaces(child_text, key_end);
+            value_text = child_text.substr(json_skip_whitespaces(child_text, colon + 1));
+            child_text = child_text.substr(0, key_end);
+        }
+        if (!(spans_known ? writer.write_raw(child_text) : writer.write_string(child->get_key_name())) ||
+            !writer.write_raw(":") || !write_node(writer, child->get_key_value_node(), value_text, spans)) {
+            return false;
+        }
+    }
+    if (const auto members = inserted.find(node); members != inserted.end()) {
+        for (const auto& member : members->second) {
+            if (!separator() || !writer.write_raw(member.key) || !writer.write_raw(":") ||
+                !writer.write_raw(member.json_text)) {
+                return false;
+            }
+        }
+    }
+    return writer.write_raw(node->is_object() ? "}" : "]");
+}
+
+/**
+ * Json text of edited tree
+ */
+inline std::string json_write(const JsonEditor& editor, const JsonWriteOptions& options = {}) {
+    JsonWriter writer(options);
+    editor.write(writer);
+    return std::string(writer.view());
+}
+
+#endif //__jsontree__jsontree_edit_hpp
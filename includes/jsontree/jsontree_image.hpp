@@ -0,0 +1,385 @@
+/*
+ * jsontree - JSON Parsing and library in C++20
+ * Copyright 2025 Marcin Markiewicz, marcin.kivrin@gmail.com
+ *
+ * This file is a part of jsontree project
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * Project: jsontree
+ *
+ */
+
+#ifndef __jsontree__jsontree_image_hpp
+#define __jsontree__jsontree_image_hpp
+
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "jsontree.hpp"
+#include "jsontree_mmap.hpp"
+
+
+enum class JsonImageError : uint8_t {
+    no_error,
+    file_error, // see get_file_error_code()
+    invalid_header,
+    unsupported_format, // other version, byte order or node layout
+    invalid_nodes,
+};
+
+/**
+ * Image starts with header, offsets are counted from the beginning of image. Nodes are stored as JsonNode
+ * objects, followed by key indexes of big objects and by the strings pool, where every string is stored once.
+ * String nodes and indexed objects keep JsonRelativeValue, offset from the node, instead of pointers.
+ */
+struct JsonImageHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t node_size;
+    uint32_t reserved;
+    uint64_t nodes_offset;
+    uint64_t nodes_count;
+    uint64_t indexes_offset;
+    uint64_t indexes_size;
+    uint64_t strings_offset;
+    uint64_t strings_size;
+};
+
+constexpr char json_image_magic[8] = {'j', 's', 'o', 'n', 't', 'r', 'e', 'e'};
+constexpr uint32_t json_image_version = 2;
+constexpr uint32_t json_image_byte_order = 0x01020304;
+
+/**
+ * Tree loaded from binary image written by json_image(), without parsing.
+ *
+ * Image is memory mapped read only (or taken from memory) and its nodes are used in place, as JsonNode objects
+ * with all their accessors. Nodes have no pointers: strings and key indexes of big objects are found at offsets
+ * from their nodes, so loading only checks the structure of nodes, one pass without writes and without
+ * allocation per node. All pages of the file stay shared in the page cache, between processes too.
+ *
+ * Image is not portable between platforms with other byte order or layout of JsonNode, such image is rejected
+ * with unsupported_format. Numbers are stored decoded, key indexes are built when the image is written.
+ */
+class JsonImage {
+    JsonMappedFile file{};
+    std::vector<char> buffer{}; // image passed by value
+    const JsonNode* nodes{nullptr};
+    size_t nodes_count{0};
+    JsonImageError error_code{JsonImageError::no_error};
+
+    bool load(const char* data, size_t size);
+    static bool check_node(const JsonNode* node, size_t remaining, const char* data, const JsonImageHeader& header);
+
+public:
+    /**
+     * Map image file. Loading reads every page of nodes, so they are mapped at once.
+     */
+    explicit JsonImage(const char* path, const JsonMappedFileOptions& options = {.populate = true})
+        : file(path, options) {
+        if (!file.valid()) {
+            error_code = JsonImageError::file_error;
+            return;
+        }
+        load(file.get_data().data(), file.get_data().size());
+    }
+
+    explicit JsonImage(std::vector<char> image) : buffer(std::move(image)) { load(buffer.data(), buffer.size()); }
+
+    /**
+     * Image in caller supplied memory, which is not changed and must outlive the image
+     */
+    JsonImage(const char* data, const size_t size) { load(data, size); }
+
+    JsonImage(const JsonImage& other) = delete;
+    JsonImage(JsonImage&& other) noexcept = delete;
+
+    [[nodiscard]] auto get_error_code() const { return error_code; }
+    [[nodiscard]] auto get_file_error_code() const { return file.get_error_code(); }
+    [[nodiscard]] auto valid() const { return error_code == JsonImageError::no_error; }
+    [[nodiscard]] const JsonNode* get_root() const { return nodes; }
+    [[nodiscard]] auto size() const { return nodes_count; }
+    [[nodiscard]] auto& get_file() const { return file; }
+
+    /**
+     * Write image of the subtree of root, false when root is nullptr
+     */
+    static bool write(const JsonNode* root, std::vector<char>& image);
+};
+
+inline bool JsonImage::write(const JsonNode* root, std::vector<char>& image) {
+    image.clear();
+    if (root == nullptr) {
+        return false;
+    }
+    JsonImageHeader header{};
+    std::memcpy(header.magic, json_image_magic, sizeof(header.magic));
+    header.version = json_image_version;
+    header.byte_order = json_image_byte_order;
+    header.node_size = sizeof(JsonNode);
+    header.nodes_offset = (sizeof(header) + alignof(JsonNode) - 1) / alignof(JsonNode) * alignof(JsonNode);
+    header.nodes_count = root->subtree_size;
+    header.indexes_offset = header.nodes_offset + header.nodes_count * sizeof(JsonNode);
+    for (size_t i = 0; i < header.nodes_count; ++i) {
+        if (root[i].is_object() && root[i].children_count >= json_key_index_min_keys) {
+            header.indexes_size += JsonKeyIndex::slots_count(root[i].children_count) * sizeof(JsonKeyIndex::Slot);
+        }
+    }
+    header.strings_offset = header.indexes_offset + header.indexes_size;
+    image.assign(header.strings_offset, 0); // zeroed, so padding of nodes is the same in every image
+    std::unordered_map<std::string_view, uint64_t> offsets{}; // keys repeat, so every string is stored once
+    auto index_offset = header.indexes_offset;
+    for (size_t i = 0; i < header.nodes_count; ++i) {
+        const auto& node = root[i];
+        const auto node_offset = header.nodes_offset + i * sizeof(JsonNode);
+        JsonRelativeValue relative{};
+        if (node.is_string()) {
+            const auto value = node.get_value_string();
+            const auto [offset, added] = offsets.try_emplace(value, image.size());
+            if (added) {
+                image.insert(image.end(), value.begin(), value.end());
+            }
+            relative = {offset->second - node_offset, value.size()};
+        } else if (node.is_object() && node.children_count >= json_key_index_min_keys) {
+            JsonKeyIndex index(node.children_count);
+            auto key = &node + 1;
+            for (uint32_t k = 0; k < node.children_count; ++k, key = key->get_next_sibling()) {
+                index.insert(json_key_hash(key->get_key_name()), static_cast<uint32_t>(key - &node));
+            }
+            const auto& slots = index.get_slots();
+            std::memcpy(image.data() + index_offset, slots.data(), slots.size() * sizeof(JsonKeyIndex::Slot));
+            relative = {index_offset - node_offset, slots.size()};
+            index_offset += slots.size() * sizeof(JsonKeyIndex::Slot);
+        }
+        // strings pool may have moved the image
+        const auto image_node = new (image.data() + node_offset) JsonNode(node.type);
+        image_node->value_type = node.value_type;
+        image_node->flags = node.flags & JsonNode::escapes_flag;
+        image_node->children_count = node.children_count;
+        image_node->subtree_size = node.subtree_size;
+        if (relative.size != 0 || node.is_string()) {
+            image_node->flags |= JsonNode::relative_flag;
+            image_node->value.v_relative = relative;
+        } else if (node.has_raw_number()) {
+            // lazy number is decoded in a copy, source tree can be read by other threads
+            auto number = node;
+            number.decode();
+            image_node->value = number.value;
+        } else if (!node.is_container()) {
+            image_node->value = node.value;
+        }
+    }
+    header.strings_size = image.size() - header.strings_offset;
+    std::memcpy(image.data(), &header, sizeof(header));
+    return true;
+}
+
+inline bool JsonImage::load(const char* data, const size_t size) {
+    JsonImageHeader header{};
+    if (data == nullptr || size < sizeof(header)) {
+        error_code = JsonImageError::invalid_header;
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, json_image_magic, sizeof(header.magic)) != 0) {
+        error_code = JsonImageError::invalid_header;
+        return false;
+    }
+    if (header.version != json_image_version || header.byte_order != json_image_byte_order ||
+        header.node_size != sizeof(JsonNode)) {
+        error_code = JsonImageError::unsupported_format;
+        return false;
+    }
+    // nodes, indexes and strings follow each other in the image
+    if (reinterpret_cast<uintptr_t>(data) % alignof(JsonNode) != 0 || header.nodes_offset % alignof(JsonNode) != 0 ||
+        header.nodes_offset > size || header.nodes_count == 0 ||
+        header.nodes_count > (size - header.nodes_offset) / sizeof(JsonNode) ||
+        header.indexes_offset != header.nodes_offset + header.nodes_count * sizeof(JsonNode) ||
+        header.indexes_size > size - header.indexes_offset ||
+        header.strings_offset != header.indexes_offset + header.indexes_size ||
+        header.strings_size > size - header.strings_offset) {
+        error_code = JsonImageError::invalid_header;
+        return false;
+    }
+    const auto image_nodes = std::launder(reinterpret_cast<const JsonNode*>(data + header.nodes_offset));
+    struct Parent {
+        size_t index;
+        size_t end;
+        uint32_t children_count;
+    };
+    std::vector<Parent> parents{};
+    for (size_t i = 0; i <= header.nodes_count; ++i) {
+        while (!parents.empty() && parents.back().end == i) {
+            if (parents.back().children_count != image_nodes[parents.back().index].children_count) {
+                error_code = JsonImageError::invalid_nodes;
+                return false;
+            }
+            parents.pop_back();
+        }
+        if (i == header.nodes_count) {
+            break;
+        }
+        const auto& node = image_nodes[i];
+        if (!check_node(&node, header.nodes_count - i, data, header)) {
+            error_code = JsonImageError::invalid_nodes;
+            return false;
+        }
+        if (parents.empty()) {
+            // only root has no parent and it spans the whole image
+            if (i != 0 || node.subtree_size != header.nodes_count) {
+                error_code = JsonImageError::invalid_nodes;
+                return false;
+            }
+        } else {
+            auto& parent = parents.back();
+            ++parent.children_count;
+            if (i + node.subtree_size > parent.end || node.is_key() != image_nodes[parent.index].is_object()) {
+                error_code = JsonImageError::invalid_nodes;
+                return false;
+            }
+        }
+        if (node.is_container() || node.is_key()) {
+            parents.push_back({i, i + node.subtree_size, 0});
+        }
+    }
+    nodes = image_nodes;
+    nodes_count = header.nodes_count;
+    return true;
+}
+
+/**
+ * Check fields of node, strings must be in the strings pool and key indexes in the indexes of the image
+ */
+inline bool JsonImage::check_node(const JsonNode* node, const size_t remaining, const char* data,
+                                  const JsonImageHeader& header) {
+    if (node->type > JsonNodeType::value || node->value_type > JsonValueType::v_uint64 ||
+        (node->flags & ~(JsonNode::escapes_flag | JsonNode::relative_flag)) != 0 || node->subtree_size == 0 ||
+        node->subtree_size > remaining) {
+        return false;
+    }
+    const auto node_offset = static_cast<uint64_t>(reinterpret_cast<const char*>(node) - data);
+    JsonRelativeValue relative{};
+    std::memcpy(&relative, &node->value, sizeof(relative));
+    const auto relative_in = [&](const uint64_t begin, const uint64_t end, const uint64_t item_size) {
+        return relative.offset <= end - node_offset && node_offset + relative.offset >= begin &&
+               relative.size <= (end - node_offset - relative.offset) / item_size;
+    };
+    if (node->is_container()) {
+        if (node->value_type != JsonValueType::v_null || (node->flags & JsonNode::escapes_flag) != 0) {
+            return false;
+        }
+        if ((node->flags & JsonNode::relative_flag) == 0) {
+            return relative.offset == 0 && relative.size == 0; // key index is not built for image
+        }
+        const auto end = header.indexes_offset + header.indexes_size;
+        if (!node->is_object() || !std::has_single_bit(relative.size) || (node_offset + relative.offset) % 4 != 0 ||
+            !relative_in(header.indexes_offset, end, sizeof(JsonKeyIndex::Slot))) {
+            return false;
+        }
+        // every slot is empty or points to key node which is a direct child, at least one slot is empty
+        std::vector<uint64_t> children{};
+        for (uint64_t child = 1; child < node->subtree_size; child += node[child].subtree_size) {
+            if (node[child].subtree_size == 0) {
+                return false;
+            }
+            children.push_back(child);
+        }
+        size_t empty_slots = 0;
+        for (uint64_t i = 0; i < relative.size; ++i) {
+            JsonKeyIndex::Slot slot{};
+            std::memcpy(&slot, data + node_offset + relative.offset + i * sizeof(slot), sizeof(slot));
+            if (slot.offset == 0) {
+                ++empty_slots;
+            } else if (!std::binary_search(children.begin(), children.end(), slot.offset) ||
+                       !node[slot.offset].is_key()) {
+                return false;
+            }
+        }
+        return empty_slots > 0;
+    }
+    if (node->is_key() && (node->value_type != JsonValueType::v_string || node->children_count != 1)) {
+        return false;
+    }
+    if (node->is_value() && (node->children_count != 0 || node->subtree_size != 1)) {
+        return false;
+    }
+    if (node->is_string()) {
+        return (node->flags & JsonNode::relative_flag) != 0 &&
+               relative_in(header.strings_offset, header.strings_offset + header.strings_size, 1);
+    }
+    if (node->flags != 0) {
+        return false;
+    }
+    if (node->value_type == JsonValueType::v_boolean) {
+        uint8_t boolean{};
+        std::memcpy(&boolean, &node->value, sizeof(boolean));
+        return boolean <= 1;
+    }
+    return true;
+}
+
+inline std::vector<char> json_image(const JsonNode* root) {
+    std::vector<char> image{};
+    JsonImage::write(root, image);
+    return image;
+}
+
+inline std::vector<char> json_image(const JsonTree& tree) {
+    return json_image(tree.valid() ? tree.get_root() : nullptr);
+}
+
+/**
+ * Write image of tree to file, false when tree is not valid or file can not be written
+ */
+inline bool json_save_image(const JsonTree& tree, const char* path) {
+    const auto image = json_image(tree);
+    if (image.empty()) {
+        return false;
+    }
+    const auto file = std::fopen(path, "wb");
+    if (file == nullptr) {
+        return false;
+    }
+    const auto written = std::fwrite(image.data(), 1, image.size(), file) == image.size();
+    return std::fclose(file) == 0 && written;
+}
+
+inline std::string get_json_image_error_message(const JsonImageError& error_code) {
+    switch (error_code) {
+    case JsonImageError::no_error:
+        return "no error";
+    case JsonImageError::file_error:
+        return "file error";
+    case JsonImageError::invalid_header:
+        return "invalid header";
+    case JsonImageError::unsupported_format:
+        return "unsupported format";
+    case JsonImageError::invalid_nodes:
+        return "invalid nodes";
+    }
+    return "unknown error";
+}
+
+
+#endif //__jsontree__jsontree_image_hpp
@@ -0,0 +1,140 @@
+/*
+ * jsontree - JSON Parsing and library in C++20
+ * Copyright 2025 Marcin Markiewicz, marcin.kivrin@gmail.com
+ *
+ * This file is a part of jsontree project
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * Project: jsontree
+ *
+ */
+
+#ifndef __jsontree__jsontree_key_index_hpp
+#define __jsontree__jsontree_key_index_hpp
+
+
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+
+/**
+ * Objects with fewer keys are searched linearly, bigger ones get hash index on the first lookup
+ */
+constexpr uint32_t json_key_index_min_keys = 16;
+
+/**
+ * FNV-1a hash of key name. It is constexpr, so hashes of known keys can be computed at compile time.
+ * Seed replaces the offset basis, it is used to search for perfect hash of a known set of keys.
+ */
+constexpr uint32_t json_key_hash(const std::string_view key, const uint32_t seed = 2166136261u) {
+    uint32_t hash = seed;
+    for (const auto c : key) {
+        hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * Open addressing hash table which maps key hash to offset of key node from its object node.
+ *
+ * Table keeps only offsets, so it does not depend on the address of the tape. Keys with equal hash are
+ * compared by the caller. Keys are inserted in document order, so with duplicated keys the first one is found.
+ */
+class JsonKeyIndex {
+public:
+    struct Slot {
+        uint32_t hash;
+        uint32_t offset; // 0 is empty slot, key nodes are always after their object node
+    };
+
+private:
+    std::vector<Slot> slots;
+    size_t mask;
+
+public:
+    explicit JsonKeyIndex(const size_t keys_count)
+        : slots(slots_count(keys_count), Slot{0, 0}), mask(slots.size() - 1) {}
+
+    [[nodiscard]] static constexpr size_t slots_count(const size_t keys_count) { return std::bit_ceil(keys_count * 2); }
+
+    /**
+     * Upper bound of memory of index with keys_count keys, with its place in the pool
+     */
+    [[nodiscard]] static constexpr size_t memory_size(const size_t keys_count) {
+        // vector of the pool grows twice, so it has at most two pointers per index
+        return sizeof(JsonKeyIndex) + 2 * sizeof(std::unique_ptr<JsonKeyIndex>) +
+               slots_count(keys_count) * sizeof(Slot);
+    }
+
+    void insert(const uint32_t hash, const uint32_t offset) {
+        auto position = hash & mask;
+        while (slots[position].offset != 0) {
+            position = (position + 1) & mask;
+        }
+        slots[position] = {hash, offset};
+    }
+
+    /**
+     * Offset of the first key for which match(offset) is true, 0 if there is none
+     */
+    template <typename Match>
+    [[nodiscard]] uint32_t find(const uint32_t hash, Match&& match) const {
+        return find(slots.data(), mask, hash, match);
+    }
+
+    /**
+     * Search in slots stored elsewhere (see JsonImage), count of slots is power of two, mask is count - 1
+     */
+    template <typename Match>
+    [[nodiscard]] static uint32_t find(const Slot* table, const size_t mask, const uint32_t hash, Match&& match) {
+        for (auto position = hash & mask; table[position].offset != 0; position = (position + 1) & mask) {
+            if (table[position].hash == hash && match(table[position].offset)) {
+                return table[position].offset;
+            }
+        }
+        return 0;
+    }
+
+    [[nodiscard]] const auto& get_slots() const { return slots; }
+};
+
+/**
+ * Key indexes of one tree. Indexes are built on demand from const nodes, so building is guarded by mutex.
+ * Pool is a member of its tree and does not allocate until the first index is built, so trees which are never
+ * searched pay nothing for it.
+ */
+struct JsonKeyIndexPool {
+    std::mutex mutex{};
+    std::vector<std::unique_ptr<JsonKeyIndex>> indexes{};
+
+    JsonKeyIndex& add(const size_t keys_count) {
+        return *indexes.emplace_back(std::make_unique<JsonKeyIndex>(keys_count));
+    }
+};
+
+/**
+ * Object node keeps pool of its tree and pointer to its index, which is null until the first lookup
+ */
+struct JsonKeyIndexRef {
+    JsonKeyIndexPool* pool;
+    const JsonKeyIndex* index;
+};
+
+
+#endif //__jsontree__jsontree_key_index_hpp
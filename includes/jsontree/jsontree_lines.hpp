@@ -0,0 +1,234 @@
+/*
+ * jsontree - JSON Parsing and library in C++20
+ * Copyright 2025 Marcin Markiewicz, marcin.kivrin@gmail.com
+ *
+ * This file is a part of jsontree project
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * Project: jsontree
+ *
+ */
+
+#ifndef __jsontree__jsontree_lines_hpp
+#define __jsontree__jsontree_lines_hpp
+
+
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <vector>
+#include "jsontree.hpp"
+#include "jsontree_parser.hpp"
+#include "jsontree_thread_pool.hpp"
+
+
+/**
+ * One record of newline delimited json
+ */
+struct JsonLine {
+    size_t offset{0}; // position of the line in json data
+    std::string_view data{}; // text of the line without new line character
+    const JsonNode* root{nullptr}; // root of the line tree, nullptr when line is not valid
+    JsonTreeParseError error_code{JsonTreeParseError::no_error};
+    size_t index{0}; // position of the error in the line, see JsonTree::get_index()
+
+    [[nodiscard]] auto valid() const { return error_code == JsonTreeParseError::no_error; }
+    [[nodiscard]] auto get_error_offset() const { return offset + index; }
+};
+
+/**
+ * Newline delimited json (JSON Lines), every line is a separate document. Lines with whitespace only are skipped.
+ *
+ * Lines are parsed on all workers of a thread pool, each worker takes small groups of lines, parses them with its
+ * own JsonParser and appends their trees to its own arena, so there is no sharing between workers apart from the
+ * group counter. Results are kept in input order. Trees of lines are read the same way as JsonTree and live as
+ * long as JsonLines.
+ */
+class JsonLines {
+    static constexpr size_t lines_per_task = 64;
+
+    struct DecodedString {
+        size_t node;
+        size_t offset;
+        size_t size;
+    };
+
+    struct Block {
+        JsonNodeArena nodes{}; // trees of all lines parsed by one worker
+        JsonParser parser{};
+        JsonDocument line{}; // tree of current line
+        std::vector<char> strings{};
+        std::vector<DecodedString> decoded_strings{};
+        JsonKeyIndexPool key_indexes{}; // blocks are not moved, so objects can point to it
+    };
+
+    struct Placement {
+        size_t block;
+        size_t node;
+    };
+
+    const std::string_view json_data;
+    std::vector<JsonLine> lines{};
+    std::vector<Placement> placements{};
+    std::vector<std::unique_ptr<Block>> blocks{};
+    size_t errors_count{0};
+    bool is_parsed_{false};
+
+    void split();
+    void parse_line(size_t line_index, size_t block_index, const JsonTreeParseOptions& options);
+    bool copy_tree(Block& block) const;
+    void set_result();
+
+public:
+    explicit JsonLines(const std::string_view json_data_) : json_data(json_data_) {}
+
+    JsonLines(const JsonLines& other) = delete;
+    JsonLines(JsonLines&& other) noexcept = delete;
+
+    /**
+     * Parse lines on workers of pool. Returns true if all lines are valid.
+     */
+    bool parse(JsonThreadPool& pool, const JsonTreeParseOptions& options = {});
+
+    /**
+     * Parse lines in the calling thread
+     */
+    bool parse(const JsonTreeParseOptions& options = {});
+
+    [[nodiscard]] auto get_json_data() const { return json_data; }
+    [[nodiscard]] auto valid() const { return is_parsed_ && errors_count == 0; }
+    [[nodiscard]] auto parsed() const { return is_parsed_; }
+    [[nodiscard]] auto get_errors_count() const { return errors_count; }
+    [[nodiscard]] auto size() const { return lines.size(); }
+    [[nodiscard]] auto empty() const { return lines.empty(); }
+    [[nodiscard]] auto begin() const { return lines.begin(); }
+    [[nodiscard]] auto end() const { return lines.end(); }
+    [[nodiscard]] const JsonLine& operator[](const size_t index) const { return lines[index]; }
+};
+
+inline bool JsonLines::parse(JsonThreadPool& pool, const JsonTreeParseOptions& options) {
+    if (is_parsed_) { return valid(); }
+    is_parsed_ = true;
+    split();
+    placements.resize(lines.size());
+    blocks.resize(pool.size());
+    for (auto& block : blocks) {
+        block = std::make_unique<Block>();
+    }
+    std::atomic<size_t> next_line{0};
+    pool.run([&](const size_t worker) {
+        while (true) {
+            const auto first = next_line.fetch_add(lines_per_task, std::memory_order_relaxed);
+            if (first >= lines.size()) {
+                break;
+            }
+            const auto last = std::min(first + lines_per_task, lines.size());
+            for (auto line_index = first; line_index < last; ++line_index) {
+                parse_line(line_index, worker, options);
+            }
+        }
+    });
+    set_result();
+    return valid();
+}
+
+inline bool JsonLines::parse(const JsonTreeParseOptions& options) {
+    JsonThreadPool pool(1);
+    return parse(pool, options);
+}
+
+/**
+ * Strings can not contain new line characters, so every new line ends a record
+ */
+inline void JsonLines::split() {
+    size_t start = 0;
+    while (start < json_data.size()) {
+        const auto found = static_cast<const char*>(
+            std::memchr(json_data.data() + start, '\n', json_data.size() - start));
+        const auto stop = found != nullptr ? static_cast<size_t>(found - json_data.data()) : json_data.size();
+        auto first = start;
+        while (first < stop && json_is_whitespace(json_data[first])) {
+            ++first;
+        }
+        if (first < stop) {
+            lines.push_back({.offset = start, .data = json_data.substr(start, stop - start)});
+        }
+        start = stop + 1;
+    }
+}
+
+inline void JsonLines::parse_line(const size_t line_index, const size_t block_index,
+                                  const JsonTreeParseOptions& options) {
+    auto& line = lines[line_index];
+    auto& block = *blocks[block_index];
+    placements[line_index] = {block_index, block.nodes.size()};
+    block.parser.parse(line.data, block.line, options);
+    line.error_code = block.line.get_error_code();
+    line.index = block.line.get_index();
+    if (line.valid() && !copy_tree(block)) {
+        line.error_code = JsonTreeParseError::out_of_memory;
+        line.index = 0;
+    }
+}
+
+/**
+ * Append nodes of line tree to the block, strings which are not views of json data are moved to the block too
+ */
+inline bool JsonLines::copy_tree(Block& block) const {
+    const auto& nodes = block.line.get_nodes();
+    const auto required = block.nodes.size() + nodes.size();
+    if (required > block.nodes.get_capacity()
+        && !block.nodes.reserve(std::max(required, block.nodes.get_capacity() * 2))) {
+        return false;
+    }
+    for (const auto node : nodes) {
+        auto& copy = *block.nodes.create(*node);
+        if (copy.is_string() || copy.has_raw_number()) {
+            const auto text = copy.value.v_string;
+            if (text.data() < json_data.data() || text.data() > json_data.data() + json_data.size()) {
+                block.decoded_strings.push_back({block.nodes.size() - 1, block.strings.size(), text.size()});
+                block.strings.insert(block.strings.end(), text.begin(), text.end());
+            }
+        } else if (copy.is_object() && copy.value.v_key_index.pool != nullptr) {
+            copy.value.v_key_index = {&block.key_indexes, nullptr};
+        }
+    }
+    return true;
+}
+
+inline void JsonLines::set_result() {
+    for (const auto& block : blocks) {
+        for (const auto& decoded : block->decoded_strings) {
+            block->nodes[decoded.node].value.v_string =
+                std::string_view(block->strings.data() + decoded.offset, decoded.size);
+        }
+        block->decoded_strings.clear();
+        block->line = {};
+    }
+    for (size_t line_index = 0; line_index < lines.size(); ++line_index) {
+        auto& line = lines[line_index];
+        if (line.valid()) {
+            line.root = &blocks[placements[line_index].block]->nodes[placements[line_index].node];
+        } else {
+            ++errors_count;
+        }
+    }
+    placements.clear();
+    placements.shrink_to_fit();
+}
+
+
+#endif //__jsontree__jsontree_lines_hpp
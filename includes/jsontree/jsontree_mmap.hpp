@@ -0,0 +1,269 @@
+/*
+ * jsontree - JSON Parsing and library in C++20
+ * Copyright 2025 Marcin Markiewicz, marcin.kivrin@gmail.com
+ *
+ * This file is a part of jsontree project
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * Project: jsontree
+ *
+ */
+
+#ifndef __jsontree__jsontree_mmap_hpp
+#define __jsontree__jsontree_mmap_hpp
+
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "jsontree.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define JSONTREE_MMAP
+#endif
+
+
+enum class JsonMappedFileError : uint8_t {
+    no_error,
+    open_failed,
+    stat_failed,
+    map_failed,
+    read_failed,
+};
+
+struct JsonMappedFileOptions {
+    bool sequential{true}; // madvise(MADV_SEQUENTIAL), pages are read ahead and dropped after use
+    bool huge_pages{false}; // madvise(MADV_HUGEPAGE), used by kernels which support huge pages for files
+    bool populate{false}; // map all pages at once (MAP_POPULATE) instead of on first access
+    bool writable{false}; // pages can be changed, changes are copy on write and never reach the file
+};
+
+/**
+ * Read only memory mapping of a whole file.
+ *
+ * Where mmap is not available the file is read into a buffer owned by the object. Empty file gives empty data
+ * without error. Writable mapping is private, its data can be changed in place through get_writable_data().
+ */
+class JsonMappedFile {
+    const char* data{nullptr};
+    size_t size{0};
+    bool mapped{false};
+    bool writable{false};
+    std::vector<char> buffer{}; // file content where mmap is not available
+    JsonMappedFileError error_code{JsonMappedFileError::no_error};
+
+    void open(const char* path, const JsonMappedFileOptions& options);
+    void read(const char* path);
+#ifdef JSONTREE_MMAP
+    void read(int fd);
+#endif
+
+public:
+    JsonMappedFile() = default;
+
+    explicit JsonMappedFile(const char* path, const JsonMappedFileOptions& options = {}) { open(path, options); }
+
+    JsonMappedFile(const JsonMappedFile& other) = delete;
+    JsonMappedFile& operator=(const JsonMappedFile& other) = delete;
+
+    JsonMappedFile(JsonMappedFile&& other) noexcept
+        : data(std::exchange(other.data, nullptr)), size(std::exchange(other.size, 0)),
+          mapped(std::exchange(other.mapped, false)), writable(std::exchange(other.writable, false)),
+          buffer(std::move(other.buffer)), error_code(other.error_code) {}
+
+    JsonMappedFile& operator=(JsonMappedFile&& other) noexcept {
+        if (this != &other) {
+            release();
+            data = std::exchange(other.data, nullptr);
+            size = std::exchange(other.size, 0);
+            mapped = std::exchange(other.mapped, false);
+            writable = std::exchange(other.writable, false);
+            buffer = std::move(other.buffer);
+            error_code = other.error_code;
+        }
+        return *this;
+    }
+
+    ~JsonMappedFile() { release(); }
+
+    void release();
+
+    [[nodiscard]] auto get_error_code() const { return error_code; }
+    [[nodiscard]] auto valid() const { return error_code == JsonMappedFileError::no_error; }
+    [[nodiscard]] auto is_mapped() const { return mapped; }
+    [[nodiscard]] std::string_view get_data() const { return {data, size}; }
+    [[nodiscard]] char* get_writable_data() const { return writable ? const_cast<char*>(data) : nullptr; }
+};
+
+inline void JsonMappedFile::open(const char* path, const JsonMappedFileOptions& options) {
+#ifdef JSONTREE_MMAP
+    const auto fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        error_code = JsonMappedFileError::open_failed;
+        return;
+    }
+    struct stat file_stat{};
+    if (::fstat(fd, &file_stat) != 0) {
+        ::close(fd);
+        error_code = JsonMappedFileError::stat_failed;
+        return;
+    }
+    if (!S_ISREG(file_stat.st_mode)) {
+        // pipes and devices can not be mapped, they are read from the open descriptor as reopening can lose data
+        read(fd);
+        return;
+    }
+    size = static_cast<size_t>(file_stat.st_size);
+    if (size == 0) {
+        ::close(fd);
+        return;
+    }
+    int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+    if (options.populate) {
+        flags |= MAP_POPULATE;
+    }
+#endif
+    const auto memory = ::mmap(nullptr, size, options.writable ? PROT_READ | PROT_WRITE : PROT_READ, flags, fd, 0);
+    ::close(fd); // mapping keeps the file
+    if (memory == MAP_FAILED) {
+        size = 0;
+        error_code = JsonMappedFileError::map_failed;
+        return;
+    }
+    data = static_cast<const char*>(memory);
+    mapped = true;
+    writable = options.writable;
+    // hints, failures are not errors
+    if (options.sequential) {
+        ::madvise(memory, size, MADV_SEQUENTIAL);
+    }
+#ifdef MADV_HUGEPAGE
+    if (options.huge_pages) {
+        ::madvise(memory, size, MADV_HUGEPAGE);
+    }
+#endif
+#else
+    (void)options;
+    read(path);
+#endif
+}
+
+inline void JsonMappedFile::read(const char* path) {
+    const auto file = std::fopen(path, "rb");
+    if (file == nullptr) {
+        error_code = JsonMappedFileError::open_failed;
+        return;
+    }
+    char block[64 * 1024];
+    size_t count;
+    while ((count = std::fread(block, 1, sizeof(block), file)) > 0) {
+        buffer.insert(buffer.end(), block, block + count);
+    }
+    if (std::ferror(file)) {
+        error_code = JsonMappedFileError::read_failed;
+        buffer.clear();
+    }
+    std::fclose(file);
+    data = buffer.data();
+    size = buffer.size();
+    writable = true; // buffer is owned
+}
+
+#ifdef JSONTREE_MMAP
+inline void JsonMappedFile::read(const int fd) {
+    char block[64 * 1024];
+    while (true) {
+        const auto count = ::read(fd, block, sizeof(block));
+        if (count > 0) {
+            buffer.insert(buffer.end(), block, block + count);
+        } else if (count == 0) {
+            break;
+        } else if (errno != EINTR) {
+            error_code = JsonMappedFileError::read_failed;
+            buffer.clear();
+            break;
+        }
+    }
+    ::close(fd);
+    data = buffer.data();
+    size = buffer.size();
+    writable = true; // buffer is owned
+}
+#endif
+
+inline void JsonMappedFile::release() {
+#ifdef JSONTREE_MMAP
+    if (mapped) {
+        ::munmap(const_cast<char*>(data), size);
+    }
+#endif
+    data = nullptr;
+    size = 0;
+    mapped = false;
+    writable = false;
+    buffer.clear();
+}
+
+/**
+ * Mapping is a base class, so it is created before the tree and released after it
+ */
+struct JsonMappedFileHolder {
+    JsonMappedFile file;
+};
+
+/**
+ * Tree of a memory mapped file. Tree owns the mapping, strings of nodes point into it and are valid for the
+ * lifetime of the tree, file content is not copied. File errors are reported by get_file_error_code(),
+ * parse() of file which could not be mapped fails with empty_json_data.
+ */
+class JsonFileTree : private JsonMappedFileHolder, public JsonTree {
+public:
+    explicit JsonFileTree(const char* path, const JsonMappedFileOptions& options = {})
+        : JsonMappedFileHolder{JsonMappedFile(path, options)}, JsonTree(file.get_data()) {}
+
+    JsonFileTree(const char* path, JsonNodeArena& arena, const JsonMappedFileOptions& options = {})
+        : JsonMappedFileHolder{JsonMappedFile(path, options)}, JsonTree(file.get_data(), arena) {}
+
+    [[nodiscard]] auto get_file_error_code() const { return file.get_error_code(); }
+    [[nodiscard]] auto& get_file() const { return file; }
+};
+
+inline std::string get_json_mapped_file_error_message(const JsonMappedFileError& error_code) {
+    switch (error_code) {
+    case JsonMappedFileError::no_error:
+        return "no error";
+    case JsonMappedFileError::open_failed:
+        return "open failed";
+    case JsonMappedFileError::stat_failed:
+        return "stat failed";
+    case JsonMappedFileError::map_failed:
+        return "map failed";
+    case JsonMappedFileError::read_failed:
+        return "read failed";
+    }
+    return "unknown error";
+}
+
+
+#endif //__jsontree__jsontree_mmap_hpp
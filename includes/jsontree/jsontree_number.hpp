@@ -0,0 +1,341 @@
+/*
+ * jsontree - JSON Parsing and library in C++20
+ * Copyright 2025 Marcin Markiewicz, marcin.kivrin@gmail.com
+ *
+ * This file is a part of jsontree project
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * Project: jsontree
+ *
+ */
+
+#ifndef __jsontree__jsontree_number_hpp
+#define __jsontree__jsontree_number_hpp
+
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cstdint>
+#include <system_error>
+#include <type_traits>
+
+
+/**
+ * Unsigned integer of fixed capacity for exact decimal to binary conversion. Limbs are little endian, only the
+ * used ones are visited, so small numbers are cheap also in constant expressions.
+ */
+class JsonBigInteger {
+    static constexpr size_t capacity = 128; // 4096 bits, enough for 801 digits scaled by 10^1125
+
+    std::array<uint32_t, capacity> limbs{};
+    size_t size{0};
+
+public:
+    constexpr JsonBigInteger() = default;
+
+    constexpr explicit JsonBigInteger(const uint32_t value) {
+        if (value != 0) {
+            limbs[0] = value;
+            size = 1;
+        }
+    }
+
+    [[nodiscard]] constexpr bool is_zero() const { return size == 0; }
+
+    [[nodiscard]] constexpr size_t bit_length() const {
+        return size == 0 ? 0 : size * 32 - static_cast<size_t>(std::countl_zero(limbs[size - 1]));
+    }
+
+    constexpr void multiply_add(const uint32_t factor, uint32_t addend) {
+        for (size_t i = 0; i < size; ++i) {
+            const auto product = uint64_t{limbs[i]} * factor + addend;
+            limbs[i] = static_cast<uint32_t>(product);
+            addend = static_cast<uint32_t>(product >> 32);
+        }
+        if (addend != 0) {
+            limbs[size++] = addend;
+        }
+    }
+
+    constexpr void multiply_power10(uint64_t exponent) {
+        for (; exponent >= 9; exponent -= 9) {
+            multiply_add(1000000000, 0);
+        }
+        uint32_t factor = 1;
+        for (; exponent > 0; --exponent) {
+            factor *= 10;
+        }
+        multiply_add(factor, 0);
+    }
+
+    constexpr void shift_left(const size_t bits) {
+        if (size == 0 || bits == 0) {
+            return;
+        }
+        const auto limbs_shift = bits / 32;
+        const auto bits_shift = bits % 32;
+        limbs[size + limbs_shift] = 0;
+        for (auto i = size; i-- > 0;) {
+            if (bits_shift != 0) {
+                limbs[i + limbs_shift + 1] |= limbs[i] >> (32 - bits_shift);
+            }
+            limbs[i + limbs_shift] = limbs[i] << bits_shift;
+        }
+        for (size_t i = 0; i < limbs_shift; ++i) {
+            limbs[i] = 0;
+        }
+        size += limbs_shift + 1;
+        while (size > 0 && limbs[size - 1] == 0) {
+            --size;
+        }
+    }
+
+    constexpr void shift_right_one() {
+        for (size_t i = 0; i < size; ++i) {
+            limbs[i] = (limbs[i] >> 1) | (i + 1 < size ? limbs[i + 1] << 31 : 0);
+        }
+        if (size > 0 && limbs[size - 1] == 0) {
+            --size;
+        }
+    }
+
+    [[nodiscard]] constexpr bool operator<(const JsonBigInteger& other) const {
+        if (size != other.size) {
+            return size < other.size;
+        }
+        for (auto i = size; i-- > 0;) {
+            if (limbs[i] != other.limbs[i]) {
+                return limbs[i] < other.limbs[i];
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Subtract other which is not greater than this number
+     */
+    constexpr void subtract(const JsonBigInteger& other) {
+        uint32_t borrow = 0;
+        for (size_t i = 0; i < size; ++i) {
+            const auto subtrahend = uint64_t{i < other.size ? other.limbs[i] : 0} + borrow;
+            borrow = limbs[i] < subtrahend ? 1 : 0;
+            limbs[i] = static_cast<uint32_t>(limbs[i] - subtrahend);
+        }
+        while (size > 0 && limbs[size - 1] == 0) {
+            --size;
+        }
+    }
+};
+
+/**
+ * Integer literal to int64_t or uint64_t, replica of std::from_chars which runs in constant expressions
+ */
+template <typename Integer>
+    requires std::is_same_v<Integer, int64_t> || std::is_same_v<Integer, uint64_t>
+constexpr std::from_chars_result json_integer_from_chars(const char* first, const char* last, Integer& value) {
+    auto p = first;
+    const bool negative = std::is_signed_v<Integer> && p != last && *p == '-';
+    if (negative) {
+        ++p;
+    }
+    const auto digits = p;
+    uint64_t magnitude = 0;
+    bool overflow = false;
+    for (; p != last && *p >= '0' && *p <= '9'; ++p) {
+        const auto digit = static_cast<uint64_t>(*p - '0');
+        overflow = overflow || magnitude > (UINT64_MAX - digit) / 10;
+        magnitude = magnitude * 10 + digit;
+    }
+    if (p == digits) {
+        return {first, std::errc::invalid_argument};
+    }
+    if constexpr (std::is_signed_v<Integer>) {
+        constexpr auto min_magnitude = uint64_t{1} << 63;
+        if (overflow || magnitude > (negative ? min_magnitude : min_magnitude - 1)) {
+            return {p, std::errc::result_out_of_range};
+        }
+        value = negative ? static_cast<int64_t>(0 - magnitude) : static_cast<int64_t>(magnitude);
+    } else {
+        if (overflow) {
+            return {p, std::errc::result_out_of_range};
+        }
+        value = magnitude;
+    }
+    return {p, std::errc{}};
+}
+
+/**
+ * Decimal literal to correctly rounded double, replica of std::from_chars (general format, number literals only)
+ * which runs in constant expressions. Numbers outside of the double range, or which round to zero, are reported
+ * as result_out_of_range, denormals are returned.
+ *
+ * Digits are read into a big integer and divided exactly by the power of ten, quotient of 63 or 64 bits and the
+ * remainder give round to nearest even. Only the first 800 significant digits are kept, the rest is replaced by
+ * one digit 1 when it is not zero: halfway points between doubles have at most 767 digits, so rounding is exact.
+ */
+constexpr std::from_chars_result json_decimal_from_chars(const char* first, const char* last, double& value) {
+    constexpr int64_t max_digits = 800;
+    auto p = first;
+    const bool negative = p != last && *p == '-';
+    if (negative) {
+        ++p;
+    }
+    JsonBigInteger mantissa;
+    int64_t digits = 0; // significant digits in mantissa
+    int64_t exponent = 0;
+    bool has_digits = false;
+    bool truncated = false;
+    uint32_t chunk = 0; // digits are added to mantissa 9 at a time
+    uint32_t chunk_scale = 1;
+    const auto add_digit = [&](const char c, const bool fraction) {
+        has_digits = true;
+        if (digits == 0 && c == '0') {
+            exponent -= fraction ? 1 : 0;
+        } else if (digits < max_digits) {
+            chunk = chunk * 10 + static_cast<uint32_t>(c - '0');
+            chunk_scale *= 10;
+            if (chunk_scale == 1000000000) {
+                mantissa.multiply_add(chunk_scale, chunk);
+                chunk = 0;
+                chunk_scale = 1;
+            }
+            ++digits;
+            exponent -= fraction ? 1 : 0;
+        } else {
+            truncated = truncated || c != '0';
+            exponent += fraction ? 0 : 1;
+        }
+    };
+    for (; p != last && *p >= '0' && *p <= '9'; ++p) {
+        add_digit(*p, false);
+    }
+    if (p != last && *p == '.') {
+        for (++p; p != last && *p >= '0' && *p <= '9'; ++p) {
+            add_digit(*p, true);
+        }
+    }
+    if (!has_digits) {
+        return {first, std::errc::invalid_argument};
+    }
+    if (p != last && (*p == 'e' || *p == 'E')) {
+        auto q = p + 1;
+        const bool negative_exponent = q != last && *q == '-';
+        if (q != last && (*q == '-' || *q == '+')) {
+            ++q;
+        }
+        if (q != last && *q >= '0' && *q <= '9') {
+            int64_t exponent_value = 0;
+            for (; q != last && *q >= '0' && *q <= '9'; ++q) {
+                exponent_value = std::min<int64_t>(exponent_value * 10 + (*q - '0'), 1000000000);
+            }
+            exponent += negative_exponent ? -exponent_value : exponent_value;
+            p = q;
+        }
+    }
+    if (truncated) {
+        chunk = chunk * 10 + 1;
+        chunk_scale *= 10;
+        ++digits;
+        --exponent;
+    }
+    mantissa.multiply_add(chunk_scale, chunk);
+    const auto sign = negative ? uint64_t{1} << 63 : 0;
+    if (digits == 0) {
+        value = std::bit_cast<double>(sign);
+        return {p, std::errc{}};
+    }
+    // number is in [10^(digits + exponent - 1), 10^(digits + exponent))
+    if (digits + exponent > 310 || digits + exponent < -324) {
+        return {p, std::errc::result_out_of_range};
+    }
+    JsonBigInteger numerator = mantissa;
+    JsonBigInteger denominator(1);
+    if (exponent > 0) {
+        numerator.multiply_power10(static_cast<uint64_t>(exponent));
+    } else {
+        denominator.multiply_power10(static_cast<uint64_t>(-exponent));
+    }
+    // scale by 2^shift, so that quotient is in [2^62, 2^64)
+    const auto numerator_bits = static_cast<int64_t>(numerator.bit_length());
+    const auto shift = 63 - numerator_bits + static_cast<int64_t>(denominator.bit_length());
+    if (shift > 0) {
+        numerator.shift_left(static_cast<size_t>(shift));
+    } else {
+        denominator.shift_left(static_cast<size_t>(-shift));
+    }
+    denominator.shift_left(63);
+    uint64_t quotient = 0;
+    for (int bit = 63; bit >= 0; --bit) {
+        if (!(numerator < denominator)) {
+            numerator.subtract(denominator);
+            quotient |= uint64_t{1} << bit;
+        }
+        denominator.shift_right_one();
+    }
+    const auto sticky = !numerator.is_zero();
+    // number is quotient * 2^-shift, bits below the 53 bit mantissa (or below denormal precision) are rounded
+    const auto top = 63 - static_cast<int64_t>(std::countl_zero(quotient));
+    auto binary_exponent = top - shift;
+    const auto dropped = binary_exponent >= -1022 ? top - 52 : shift - 1074;
+    if (dropped > 64) {
+        return {p, std::errc::result_out_of_range};
+    }
+    uint64_t bits = 0;
+    if (dropped == 64) {
+        constexpr auto half = uint64_t{1} << 63;
+        bits = quotient > half || (quotient == half && sticky) ? 1 : 0;
+    } else {
+        const auto half = uint64_t{1} << (dropped - 1);
+        const auto remainder = quotient & ((half << 1) - 1);
+        bits = quotient >> dropped;
+        if (remainder > half || (remainder == half && (sticky || (bits & 1) != 0))) {
+            ++bits;
+        }
+    }
+    constexpr auto hidden_bit = uint64_t{1} << 52;
+    if (binary_exponent >= -1022) {
+        if (bits == hidden_bit << 1) {
+            bits >>= 1;
+            ++binary_exponent;
+        }
+        if (binary_exponent > 1023) {
+            return {p, std::errc::result_out_of_range};
+        }
+        bits = (static_cast<uint64_t>(binary_exponent + 1023) << 52) | (bits & (hidden_bit - 1));
+    } else if (bits == 0) {
+        return {p, std::errc::result_out_of_range};
+    }
+    value = std::bit_cast<double>(bits | sign);
+    return {p, std::errc{}};
+}
+
+/**
+ * std::from_chars for numbers of json data, replaced by the replicas above in constant expressions
+ */
+template <typename Number>
+constexpr std::from_chars_result json_from_chars(const char* first, const char* last, Number& value) {
+    if (std::is_constant_evaluated()) {
+        if constexpr (std::is_same_v<Number, double>) {
+            return json_decimal_from_chars(first, last, value);
+        } else {
+            return json_integer_from_chars(first, last, value);
+        }
+    }
+    return std::from_chars(first, last, value);
+}
+
+#endif //__jsontree__jsontree_number_hpp
@@ -0,0 +1,187 @@
+/*
+ * jsontree - JSON Parsing and library in C++20
+ * Copyright 2025 Marcin Markiewicz, marcin.kivrin@gmail.com
+ *
+ * This file is a part of jsontree project
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * Project: jsontree
+ *
+ */
+
+#ifndef __jsontree__jsontree_parallel_hpp
+#define __jsontree__jsontree_parallel_hpp
+
+
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <vector>
+#include "jsontree.hpp"
+#include "jsontree_thread_pool.hpp"
+
+
+/**
+ * Parser of one big top level array on all workers of a thread pool.
+ *
+ * Commas of the top level array are found by a quote aware scan of structural characters, items between them
+ * are split into ranges which are parsed into separate tapes at the same time. Nodes of the ranges are copied
+ * under one root array node in the storage of the tree, so the tree is the same as from JsonTree::parse(). Data
+ * which is not an array, is too small to split, has an error in any range or does not fit in the arena of the
+ * tree is parsed by JsonTree::parse(), so error codes and indexes are always the same as from serial parsing.
+ */
+class JsonParallelParser {
+    static constexpr size_t ranges_per_worker = 4; // more ranges than workers to even out the load
+
+    /**
+     * Tape of one range, root is an array node. Big objects point to the key index pool of the tree already.
+     */
+    struct Range {
+        JsonNodeArena nodes{};
+        std::vector<char> strings{};
+        size_t strings_offset{0}; // position of strings in the strings buffer of the tree
+    };
+
+    JsonThreadPool& pool;
+    size_t min_range;
+    std::vector<size_t> commas{};
+
+    bool parse_ranges(JsonTree& tree, size_t begin, size_t end, const JsonTreeParseOptions& options);
+    bool join_ranges(std::string_view data, JsonTreeStorage storage, std::vector<std::unique_ptr<Range>>& ranges);
+
+public:
+    static constexpr size_t default_min_range = 1024 * 1024;
+
+    /**
+     * Ranges are at least min_range bytes long, smaller data is parsed by the calling thread only
+     */
+    explicit JsonParallelParser(JsonThreadPool& pool_, const size_t min_range_ = default_min_range)
+        : pool(pool_), min_range(min_range_ > 0 ? min_range_ : 1) {}
+
+    /**
+     * Parse data of tree, same as tree.parse(options). Returns true if tree is valid.
+     */
+    bool parse(JsonTree& tree, const JsonTreeParseOptions& options = {});
+};
+
+inline bool JsonParallelParser::parse(JsonTree& tree, const JsonTreeParseOptions& options) {
+    if (tree.parsed()) { return tree.valid(); }
+    const auto data = tree.get_json_data();
+    const auto first = json_skip_whitespaces(data, 0);
+    if (pool.size() > 1 && data.size() >= 2 * min_range && first < data.size() && data[first] == '[') {
+        const auto range = std::max(min_range, data.size() / (pool.size() * ranges_per_worker));
+        const auto end = json_find_array_boundaries(data, range, commas);
+        if (!commas.empty() && end < data.size() && data[end] == ']'
+            && json_skip_whitespaces(data, end + 1) == data.size()
+            && parse_ranges(tree, first, end, options)) {
+            return true;
+        }
+    }
+    return tree.parse(options);
+}
+
+/**
+ * Every range is parsed as items of an array, the array node is the root of the range tape. Returns false if any
+ * range is not valid or ranges can not be joined, tree is left empty then.
+ */
+inline bool JsonParallelParser::parse_ranges(JsonTree& tree, const size_t begin, const size_t end,
+                                             const JsonTreeParseOptions& options) {
+    const auto count = commas.size() + 1;
+    const auto data = tree.get_json_data();
+    const auto storage = tree.get_storage();
+    std::vector<std::unique_ptr<Range>> ranges(count);
+    std::atomic<size_t> next_range{0};
+    std::atomic<bool> failed{false};
+    pool.run([&](size_t) {
+        JsonTreeBuilder builder;
+        for (auto range = next_range++; range < count && !failed.load(std::memory_order_relaxed);
+             range = next_range++) {
+            auto part = std::make_unique<Range>();
+            builder.reset(data, part->nodes, part->strings, storage.key_indexes);
+            JsonSaxParser<JsonTreeBuilder> parser(data, builder);
+            if (builder.on_array_start()
+                && parser.parse_array_items(range == 0 ? begin + 1 : commas[range - 1] + 1,
+                                            range + 1 < count ? commas[range] : end, options)) {
+                builder.on_array_end();
+            }
+            builder.finish();
+            if (parser.get_error_code() != JsonTreeParseError::no_error) {
+                failed = true;
+            }
+            ranges[range] = std::move(part);
+        }
+    });
+    if (failed || !join_ranges(data, storage, ranges)) {
+        storage.nodes.clear();
+        storage.strings.clear();
+        storage.key_indexes.indexes.clear();
+        return false;
+    }
+    tree.set_built(options);
+    return true;
+}
+
+/**
+ * Copy nodes of range tapes without their roots under one root and decoded strings of ranges into one buffer,
+ * string nodes which are not views of json data are pointed to their new place while copied
+ */
+inline bool JsonParallelParser::join_ranges(const std::string_view data, const JsonTreeStorage storage,
+                                            std::vector<std::unique_ptr<Range>>& ranges) {
+    std::vector<size_t> offsets(ranges.size());
+    size_t nodes_count = 1;
+    size_t strings_size = 0;
+    uint32_t children_count = 0;
+    for (size_t range = 0; range < ranges.size(); ++range) {
+        offsets[range] = nodes_count;
+        nodes_count += ranges[range]->nodes.size() - 1;
+        children_count += ranges[range]->nodes[0].children_count;
+        ranges[range]->strings_offset = strings_size;
+        strings_size += ranges[range]->strings.size();
+    }
+    if (storage.nodes.create(JsonNodeType::array) == nullptr || storage.nodes.allocate(nodes_count - 1) == nullptr) {
+        return false;
+    }
+    storage.strings.resize(strings_size);
+    auto& root = storage.nodes[0];
+    root.children_count = children_count;
+    root.subtree_size = static_cast<uint32_t>(nodes_count);
+    std::atomic<size_t> next_range{0};
+    pool.run([&](size_t) {
+        for (auto range = next_range++; range < ranges.size(); range = next_range++) {
+            auto& part = *ranges[range];
+            const auto part_strings = part.strings.data();
+            const auto strings = storage.strings.data() + part.strings_offset;
+            if (!part.strings.empty()) {
+                std::memcpy(strings, part_strings, part.strings.size());
+            }
+            const auto first = &storage.nodes[offsets[range]];
+            const auto size = part.nodes.size() - 1;
+            std::memcpy(static_cast<void*>(first), &part.nodes[1], size * sizeof(JsonNode));
+            for (auto node = first; node != first + size && !part.strings.empty(); ++node) {
+                const auto value = node->value.v_string;
+                if ((node->is_string() || node->has_raw_number())
+                    && (value.data() < data.data() || value.data() > data.data() + data.size())) {
+                    node->value.v_string = std::string_view(strings + (value.data() - part_strings), value.size());
+                }
+            }
+            part.nodes.release();
+        }
+    });
+    return true;
+}
+
+
+#endif //__jsontree__jsontree_parallel_hpp
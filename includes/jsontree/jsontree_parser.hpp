@@ -0,0 +1,173 @@
+/*
+ * jsontree - JSON Parsing and library in C++20
+ * Copyright 2025 Marcin Markiewicz, marcin.kivrin@gmail.com
+ *
+ * This file is a part of jsontree project
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * Project: jsontree
+ *
+ */
+
+#ifndef __jsontree__jsontree_parser_hpp
+#define __jsontree__jsontree_parser_hpp
+
+
+#include <memory>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "jsontree.hpp"
+
+
+/**
+ * Result of JsonParser: nodes, decoded strings and key indexes of one json data, read the same way as JsonTree.
+ *
+ * Document can be moved, nodes stay in place, so node pointers are still valid after the move. Json data must
+ * outlive the document. Document passed again to JsonParser::parse() is cleared and its memory is reused.
+ * Key index pool is a member of the document, so moving a document with objects big enough to be indexed points
+ * these objects to the pool of the new document, which is one pass over the nodes.
+ */
+class JsonDocument {
+    std::string_view json_data{};
+    JsonNodeArena nodes{};
+    std::vector<char> strings{}; // decoded strings which contain escape sequences
+    JsonKeyIndexPool key_indexes{};
+    size_t indexed_objects{0};
+    size_t key_indexes_size{0};
+    JsonTreeParseError error_code{JsonTreeParseError::no_error};
+    bool is_valid_{false};
+    bool is_parsed_{false};
+    size_t index{0};
+
+    friend class JsonParser;
+
+    void move_from(JsonDocument& other);
+
+public:
+    JsonDocument() = default;
+
+    /**
+     * Document with nodes in a caller supplied buffer, see JsonNodeArena
+     */
+    JsonDocument(void* buffer, const size_t buffer_size, const bool heap_fallback = false)
+        : nodes(buffer, buffer_size, heap_fallback) {}
+
+    JsonDocument(const JsonDocument& other) = delete;
+    JsonDocument(JsonDocument&& other) noexcept : nodes(std::move(other.nodes)) { move_from(other); }
+
+    JsonDocument& operator=(JsonDocument&& other) noexcept {
+        if (this != &other) {
+            nodes = std::move(other.nodes);
+            move_from(other);
+        }
+        return *this;
+    }
+
+    [[nodiscard]] auto get_json_data() const { return json_data; }
+    [[nodiscard]] auto get_error_code() const { return error_code; }
+    [[nodiscard]] auto valid() const { return is_valid_; }
+    [[nodiscard]] auto parsed() const { return is_parsed_; }
+    [[nodiscard]] auto get_index() const { return index; }
+    [[nodiscard]] auto get_root() const { return nodes.empty() ? nullptr : nodes.front(); }
+    [[nodiscard]] auto& get_arena() const { return nodes; }
+    [[nodiscard]] auto empty() const { return nodes.empty(); }
+    [[nodiscard]] auto& get_nodes() const { return nodes; }
+    [[nodiscard]] auto& get_strings() const { return strings; }
+
+    /**
+     * Memory of key indexes when all big objects are searched, indexes are built by the first lookups
+     */
+    [[nodiscard]] auto get_key_indexes_size() const { return key_indexes_size; }
+};
+
+inline void JsonDocument::move_from(JsonDocument& other) {
+    json_data = other.json_data;
+    strings = std::move(other.strings);
+    key_indexes.indexes = std::move(other.key_indexes.indexes);
+    indexed_objects = std::exchange(other.indexed_objects, 0);
+    key_indexes_size = std::exchange(other.key_indexes_size, 0);
+    error_code = other.error_code;
+    is_valid_ = std::exchange(other.is_valid_, false);
+    is_parsed_ = std::exchange(other.is_parsed_, false);
+    index = other.index;
+    if (indexed_objects == 0) {
+        return;
+    }
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        auto& node = nodes[i];
+        if (node.is_object() && node.value.v_key_index.pool != nullptr) {
+            node.value.v_key_index.pool = &key_indexes;
+        }
+    }
+}
+
+/**
+ * Long lived parser, keeps its stacks and buffers between documents.
+ *
+ * Parser which gets the same document in parse(json_data, document) stops allocating for documents of similar
+ * size: its own buffers keep their memory and the document reuses its nodes and strings memory.
+ * parse(json_data, options) returns a new document each time, which allocates its nodes (as many as the previous
+ * document had) and strings. One parser is used by one thread at a time.
+ */
+class JsonParser {
+    JsonTreeBuilder builder{};
+    JsonSaxParser<JsonTreeBuilder> parser{builder};
+    size_t last_nodes_count{0};
+
+public:
+    JsonParser() = default;
+
+    JsonParser(const JsonParser& other) = delete;
+    JsonParser(JsonParser&& other) noexcept = delete;
+
+    /**
+     * Parse json data into document, previous content of document is dropped. Returns true if document is valid.
+     */
+    bool parse(std::string_view json_data, JsonDocument& document, const JsonTreeParseOptions& options = {});
+
+    [[nodiscard]] JsonDocument parse(const std::string_view json_data, const JsonTreeParseOptions& options = {}) {
+        JsonDocument document;
+        document.nodes.reserve(last_nodes_count);
+        parse(json_data, document, options);
+        return document;
+    }
+};
+
+inline bool JsonParser::parse(const std::string_view json_data, JsonDocument& document,
+                              const JsonTreeParseOptions& options) {
+    document.json_data = json_data;
+    document.nodes.clear();
+    document.strings.clear();
+    document.key_indexes.indexes.clear();
+    builder.reset(json_data, document.nodes, document.strings, document.key_indexes);
+    parser.reset(json_data);
+    parser.parse(options);
+    builder.finish();
+    document.indexed_objects = builder.get_indexed_objects();
+    document.key_indexes_size = builder.get_key_indexes_size();
+    document.error_code = parser.get_error_code();
+    if (document.error_code == JsonTreeParseError::stopped_by_handler) {
+        document.error_code = JsonTreeParseError::out_of_memory; // the only reason to stop
+    }
+    document.index = parser.get_index();
+    document.is_parsed_ = true;
+    document.is_valid_ = document.error_code == JsonTreeParseError::no_error;
+    last_nodes_count = document.nodes.size();
+    return document.is_valid_;
+}
+
+
+#endif //__jsontree__jsontree_parser_hpp
@@ -0,0 +1,370 @@
+/*
+ * jsontree - JSON Parsing and library in C++20
+ * Copyright 2025 Marcin Markiewicz, marcin.kivrin@gmail.com
+ *
+ * This file is a part of jsontree project
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * Project: jsontree
+ *
+ */
+
+#ifndef __jsontree__jsontree_query_hpp
+#define __jsontree__jsontree_query_hpp
+
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "jsontree.hpp"
+
+
+enum class JsonQueryError : uint8_t {
+    no_error,
+    pointer_must_start_with_slash,
+    invalid_pointer_escape,
+    unexpected_character,
+    empty_key,
+    invalid_array_index,
+    unclosed_bracket,
+};
+
+enum class JsonQueryStepType : uint8_t {
+    key, // member of object
+    index, // item of array
+    key_or_index, // JSON Pointer token made of digits, meaning depends on the node
+    wildcard, // all items of array or all values of object
+};
+
+struct JsonQueryStep {
+    JsonQueryStepType type;
+    uint32_t key_hash{0};
+    uint32_t index{0};
+    std::string key{};
+};
+
+/**
+ * Query compiled once and run against many trees.
+ *
+ * Query is created from JSON Pointer (RFC 6901), e.g. "/servers/3/ports/0", or from path, e.g.
+ * "servers[3].ports[*]". Path is made of names separated by dots, array indexes and wildcards in brackets,
+ * "*" in place of name is wildcard too and names with special characters can be quoted: ["a.b"]. Steps keep
+ * decoded keys with their hashes, so running the query costs only hash lookups and walks over array items.
+ * Query resolves to value nodes (values of keys and items of arrays), empty query resolves to the root.
+ */
+class JsonQuery {
+    std::vector<JsonQueryStep> steps{};
+    JsonQueryError error_code{JsonQueryError::no_error};
+    size_t error_index{0};
+
+    void add_key(std::string key, JsonQueryStepType type = JsonQueryStepType::key);
+    void set_error(JsonQueryError error, size_t index);
+    void compile_pointer(std::string_view pointer);
+    void compile_path(std::string_view path);
+    size_t compile_path_bracket(std::string_view path, size_t index);
+
+    template <typename F>
+    bool visit(const JsonNode* node, size_t step_index, F& f) const;
+
+    static const JsonNode* get_array_item(const JsonNode* node, uint32_t index);
+
+public:
+    JsonQuery() = default;
+
+    static JsonQuery from_pointer(const std::string_view pointer) {
+        JsonQuery query{};
+        query.compile_pointer(pointer);
+        return query;
+    }
+
+    static JsonQuery from_path(const std::string_view path) {
+        JsonQuery query{};
+        query.compile_path(path);
+        return query;
+    }
+
+    [[nodiscard]] auto valid() const { return error_code == JsonQueryError::no_error; }
+    [[nodiscard]] auto get_error_code() const { return error_code; }
+    [[nodiscard]] auto get_error_index() const { return error_index; }
+    [[nodiscard]] auto& get_steps() const { return steps; }
+
+    /**
+     * First node matched by the query in document order, nullptr if there is none or query is not valid
+     */
+    [[nodiscard]] const JsonNode* find(const JsonNode* root) const {
+        const JsonNode* result = nullptr;
+        auto store = [&result](const JsonNode* node) {
+            result = node;
+            return true;
+        };
+        if (valid() && root != nullptr) {
+            visit(root, 0, store);
+        }
+        return result;
+    }
+
+    [[nodiscard]] const JsonNode* find(const JsonTree& tree) const {
+        return tree.valid() ? find(tree.get_root()) : nullptr;
+    }
+
+    /**
+     * Call f(const JsonNode*) for every node matched by the query, in document order
+     */
+    template <typename F>
+    void for_each(const JsonNode* root, F&& f) const {
+        auto call = [&f](const JsonNode* node) {
+            f(node);
+            return false;
+        };
+        if (valid() && root != nullptr) {
+            visit(root, 0, call);
+        }
+    }
+
+    template <typename F>
+    void for_each(const JsonTree& tree, F&& f) const {
+        if (tree.valid()) {
+            for_each(tree.get_root(), std::forward<F>(f));
+        }
+    }
+
+    [[nodiscard]] std::vector<const JsonNode*> find_all(const JsonTree& tree) const {
+        std::vector<const JsonNode*> result{};
+        for_each(tree, [&result](const JsonNode* node) { result.push_back(node); });
+        return result;
+    }
+};
+
+inline void JsonQuery::add_key(std::string key, const JsonQueryStepType type) {
+    const auto key_hash = json_key_hash(key);
+    steps.push_back({type, key_hash, 0, std::move(key)});
+}
+
+inline void JsonQuery::set_error(const JsonQueryError error, const size_t index) {
+    if (error_code == JsonQueryError::no_error) {
+        error_code = error;
+        error_index = index;
+    }
+    steps.clear();
+}
+
+/**
+ * Parse array index, digits without leading zeros which fit uint32_t
+ */
+inline bool json_query_parse_index(const std::string_view text, uint32_t& index) {
+    if (text.empty() || (text.size() > 1 && text[0] == '0')) {
+        return false;
+    }
+    const auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), index);
+    return ec == std::errc() && ptr == text.data() + text.size();
+}
+
+inline void JsonQuery::compile_pointer(const std::string_view pointer) {
+    if (pointer.empty()) {
+        return;
+    }
+    if (pointer[0] != '/') {
+        set_error(JsonQueryError::pointer_must_start_with_slash, 0);
+        return;
+    }
+    size_t start = 1;
+    while (true) {
+        const auto end = std::min(pointer.find('/', start), pointer.size());
+        std::string key{};
+        key.reserve(end - start);
+        for (size_t i = start; i < end; ++i) {
+            if (pointer[i] != '~') {
+                key += pointer[i];
+            } else if (i + 1 < end && (pointer[i + 1] == '0' || pointer[i + 1] == '1')) {
+                key += pointer[++i] == '0' ? '~' : '/';
+            } else {
+                set_error(JsonQueryError::invalid_pointer_escape, i);
+                return;
+            }
+        }
+        uint32_t index;
+        if (json_query_parse_index(key, index)) {
+            add_key(std::move(key), JsonQueryStepType::key_or_index);
+            steps.back().index = index;
+        } else {
+            add_key(std::move(key));
+        }
+        if (end == pointer.size()) {
+            return;
+        }
+        start = end + 1;
+    }
+}
+
+inline void JsonQuery::compile_path(const std::string_view path) {
+    size_t index = 0;
+    bool expect_name = true; // at start and after dot
+    while (index < path.size() && valid()) {
+        const auto c = path[index];
+        if (c == '[') {
+            index = compile_path_bracket(path, index);
+            expect_name = false;
+            continue;
+        }
+        if (expect_name) {
+            const auto end = std::min(path.find_first_of(".[]", index), path.size());
+            if (end == index) {
+                set_error(JsonQueryError::empty_key, index);
+                return;
+            }
+            const auto name = path.substr(index, end - index);
+            if (name == "*") {
+                steps.push_back({JsonQueryStepType::wildcard});
+            } else {
+                add_key(std::string(name));
+            }
+            index = end;
+            expect_name = false;
+            continue;
+        }
+        if (c != '.') {
+            set_error(JsonQueryError::unexpected_character, index);
+            return;
+        }
+        if (index + 1 == path.size()) {
+            set_error(JsonQueryError::empty_key, index + 1);
+            return;
+        }
+        ++index;
+        expect_name = true;
+    }
+}
+
+/**
+ * Compile [N], [*] or ["name"] at index, returns index after closing bracket
+ */
+inline size_t JsonQuery::compile_path_bracket(const std::string_view path, const size_t index) {
+    const auto start = index + 1;
+    if (start < path.size() && path[start] == '"') {
+        std::string key{};
+        for (auto i = start + 1; i < path.size(); ++i) {
+            if (path[i] == '\\' && i + 1 < path.size()) {
+                key += path[++i];
+            } else if (path[i] == '"') {
+                if (i + 1 == path.size() || path[i + 1] != ']') {
+                    set_error(JsonQueryError::unclosed_bracket, i + 1);
+                    return path.size();
+                }
+                add_key(std::move(key));
+                return i + 2;
+            } else {
+                key += path[i];
+            }
+        }
+        set_error(JsonQueryError::unclosed_bracket, path.size());
+        return path.size();
+    }
+    const auto end = path.find(']', start);
+    if (end == std::string_view::npos) {
+        set_error(JsonQueryError::unclosed_bracket, path.size());
+        return path.size();
+    }
+    const auto text = path.substr(start, end - start);
+    if (text == "*") {
+        steps.push_back({JsonQueryStepType::wildcard});
+        return end + 1;
+    }
+    uint32_t array_index;
+    if (!json_query_parse_index(text, array_index)) {
+        set_error(JsonQueryError::invalid_array_index, start);
+        return path.size();
+    }
+    steps.push_back({JsonQueryStepType::index, 0, array_index});
+    return end + 1;
+}
+
+inline const JsonNode* JsonQuery::get_array_item(const JsonNode* node, const uint32_t index) {
+    if (index >= node->get_children_count()) {
+        return nullptr;
+    }
+    auto item = node->get_children().front();
+    for (uint32_t i = 0; i < index; ++i) {
+        item = item->get_next_sibling();
+    }
+    return item;
+}
+
+/**
+ * Match steps from step_index on node, f returns true to stop the search. Returns true when stopped.
+ */
+template <typename F>
+bool JsonQuery::visit(const JsonNode* node, const size_t step_index, F& f) const {
+    if (step_index == steps.size()) {
+        return f(node);
+    }
+    const auto& step = steps[step_index];
+    const JsonNode* next = nullptr;
+    switch (step.type) {
+    case JsonQueryStepType::key:
+        if (const auto key = node->find(step.key, step.key_hash)) {
+            next = key->get_key_value_node();
+        }
+        break;
+    case JsonQueryStepType::index:
+        if (node->is_array()) {
+            next = get_array_item(node, step.index);
+        }
+        break;
+    case JsonQueryStepType::key_or_index:
+        if (node->is_array()) {
+            next = get_array_item(node, step.index);
+        } else if (const auto key = node->find(step.key, step.key_hash)) {
+            next = key->get_key_value_node();
+        }
+        break;
+    case JsonQueryStepType::wildcard:
+        if (node->is_container()) {
+            for (auto const child : node->get_children()) {
+                const auto item = child->is_key() ? child->get_key_value_node() : child;
+                if (visit(item, step_index + 1, f)) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+    return next != nullptr && visit(next, step_index + 1, f);
+}
+
+inline std::string get_json_query_error_message(const JsonQueryError& error_code) {
+    switch (error_code) {
+    case JsonQueryError::no_error:
+        return "no error";
+    case JsonQueryError::pointer_must_start_with_slash:
+        return "pointer must start with slash";
+    case JsonQueryError::invalid_pointer_escape:
+        return "invalid pointer escape";
+    case JsonQueryError::unexpected_character:
+        return "unexpected character";
+    case JsonQueryError::empty_key:
+        return "empty key";
+    case JsonQueryError::invalid_array_index:
+        return "invalid array index";
+    case JsonQueryError::unclosed_bracket:
+        return "unclosed bracket";
+    }
+    return "unknown error";
+}
+
+
+#endif //__jsontree__jsontree_query_hpp
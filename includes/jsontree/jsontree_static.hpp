@@ -0,0 +1,357 @@
+/*
+* jsontree - JSON Parsing and library in C++20
+ * Copyright 2025 Marcin Markiewicz, marcin.kivrin@gmail.com
+ *
+ * This file is a part of jsontree project
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * Project: jsontree
+ *
+ */
+
+#ifndef __jsontree__jsontree_static_hpp
+#define __jsontree__jsontree_static_hpp
+
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "jsontree.hpp"
+
+
+/**
+ * String literal passed as template argument, json_static_tree<R"({"a": 1})"> keeps its own copy of the text.
+ */
+template <size_t Size>
+struct JsonLiteral {
+    char data[Size]{};
+
+    constexpr JsonLiteral(const char (&text)[Size]) {
+        for (size_t i = 0; i < Size; ++i) {
+            data[i] = text[i];
+        }
+    }
+
+    [[nodiscard]] constexpr std::string_view view() const { return {data, Size - 1}; }
+};
+
+/**
+ * String of static node, position in the strings table of its tree
+ */
+struct JsonStaticString {
+    uint32_t offset;
+    uint32_t size;
+};
+
+union JsonStaticValue {
+    int v_int{};
+    int64_t v_int64;
+    uint64_t v_uint64;
+    double v_double;
+    bool v_boolean;
+    JsonStaticString v_string;
+};
+
+template <typename Node>
+class JsonStaticBuilder;
+
+/**
+ * Node of a tree built at compile time, see JsonStaticTree. It has the accessors of JsonNode and the same tape
+ * layout, so code templated on node type reads both.
+ *
+ * Node has no mutable members (numbers are never lazy, objects have no key index) and strings are offsets into
+ * the strings table of Tree instead of pointers. Table of nodes is then a constant without relocations, compiler
+ * places it in read-only data and accessors can be used in constant expressions.
+ */
+template <typename Tree>
+class JsonStaticNode {
+    JsonNodeType type{JsonNodeType::value};
+    JsonValueType value_type{JsonValueType::v_null};
+    bool escapes{false};
+    uint32_t children_count{0};
+    uint32_t subtree_size{1}; // offset to the next sibling
+    JsonStaticValue value{};
+
+    template <typename Node>
+    friend class JsonStaticBuilder;
+
+    constexpr JsonStaticNode(const JsonNodeType type_, const JsonValueType value_type_, const JsonStaticValue value_)
+        : type(type_), value_type(value_type_), value(value_) {}
+
+public:
+    JsonStaticNode() = default;
+
+    [[nodiscard]] constexpr auto is_array() const { return type == JsonNodeType::array; }
+    [[nodiscard]] constexpr auto is_object() const { return type == JsonNodeType::object; }
+    [[nodiscard]] constexpr auto is_container() const {
+        return type == JsonNodeType::object || type == JsonNodeType::array;
+    }
+
+    [[nodiscard]] constexpr auto is_key() const { return type == JsonNodeType::key; }
+    [[nodiscard]] constexpr auto is_value() const { return type == JsonNodeType::value; }
+    [[nodiscard]] constexpr auto is_string() const { return value_type == JsonValueType::v_string; }
+    [[nodiscard]] constexpr auto is_int() const { return value_type == JsonValueType::v_int; }
+    [[nodiscard]] constexpr auto is_int64() const { return value_type == JsonValueType::v_int64; }
+    [[nodiscard]] constexpr auto is_uint64() const { return value_type == JsonValueType::v_uint64; }
+    [[nodiscard]] constexpr auto is_integer() const { return is_int() || is_int64() || is_uint64(); }
+    [[nodiscard]] constexpr auto is_double() const { return value_type == JsonValueType::v_double; }
+    [[nodiscard]] constexpr auto is_boolean() const { return value_type == JsonValueType::v_boolean; }
+    [[nodiscard]] constexpr auto is_null() const { return value_type == JsonValueType::v_null; }
+    [[nodiscard]] constexpr auto get_type() const { return type; }
+    [[nodiscard]] constexpr auto get_value_type() const { return value_type; }
+    [[nodiscard]] constexpr JsonValue get_value() const;
+
+    [[nodiscard]] constexpr std::string_view get_value_string() const {
+        return is_string() ? std::string_view(Tree::get_strings().data() + value.v_string.offset, value.v_string.size)
+                           : std::string_view{};
+    }
+
+    [[nodiscard]] constexpr auto get_value_int() const { return value.v_int; }
+
+    // integers which fit in int are stored as v_int, wider ones as v_int64, above INT64_MAX as v_uint64
+    [[nodiscard]] constexpr int64_t get_value_int64() const { return is_int() ? get_value_int() : value.v_int64; }
+    [[nodiscard]] constexpr uint64_t get_value_uint64() const {
+        return is_uint64() ? value.v_uint64 : get_value_int64();
+    }
+
+    [[nodiscard]] constexpr auto get_value_double() const { return value.v_double; }
+    [[nodiscard]] constexpr auto has_escapes() const { return escapes; }
+    [[nodiscard]] constexpr auto has_raw_number() const { return false; }
+    [[nodiscard]] constexpr auto get_raw_number() const { return std::string_view{}; }
+    [[nodiscard]] constexpr auto get_value_boolean() const { return value.v_boolean; }
+    [[nodiscard]] constexpr auto get_children_count() const { return children_count; }
+    [[nodiscard]] constexpr auto get_subtree_size() const { return subtree_size; }
+
+    [[nodiscard]] constexpr JsonBasicNodeChildren<JsonStaticNode> get_children() const {
+        return {this + 1, children_count};
+    }
+
+    [[nodiscard]] constexpr auto get_key_name() const { return get_value_string(); }
+    [[nodiscard]] constexpr const JsonStaticNode* get_key_value_node() const { return this + 1; }
+    [[nodiscard]] constexpr const JsonStaticNode* get_next_sibling() const { return this + subtree_size; }
+
+    /**
+     * Key node with given name in object node, nullptr if there is no such key or node is not object.
+     * Objects are searched linearly, key_hash is accepted for the same calls as on JsonNode.
+     */
+    [[nodiscard]] constexpr const JsonStaticNode* find(std::string_view key) const;
+    [[nodiscard]] constexpr const JsonStaticNode* find(std::string_view key, uint32_t) const { return find(key); }
+};
+
+template <typename Tree>
+constexpr JsonValue JsonStaticNode<Tree>::get_value() const {
+    switch (value_type) {
+    case JsonValueType::v_int:
+        return {.v_int = value.v_int};
+    case JsonValueType::v_int64:
+        return {.v_int64 = value.v_int64};
+    case JsonValueType::v_uint64:
+        return {.v_uint64 = value.v_uint64};
+    case JsonValueType::v_double:
+        return {.v_double = value.v_double};
+    case JsonValueType::v_boolean:
+        return {.v_boolean = value.v_boolean};
+    case JsonValueType::v_string:
+        return {.v_string = get_value_string()};
+    default:
+        return {};
+    }
+}
+
+template <typename Tree>
+constexpr const JsonStaticNode<Tree>* JsonStaticNode<Tree>::find(const std::string_view key) const {
+    if (!is_object()) {
+        return nullptr;
+    }
+    for (auto const node : get_children()) {
+        if (node->get_key_name() == key) {
+            return node;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * Handler of JsonSaxParser which builds static nodes in constant expressions, links them the same way as
+ * JsonTreeBuilder does. Strings table starts with the json data, strings without escape sequences are its parts,
+ * decoded strings are appended to it.
+ */
+template <typename Node>
+class JsonStaticBuilder {
+    std::string_view json_data;
+    std::vector<Node> nodes{}; // allocation is allowed in constant expressions if it is freed there
+    std::vector<char> strings{};
+    std::vector<uint32_t> parents{}; // indexes of open containers and keys
+
+    constexpr Node& parent() { return nodes[parents.back()]; }
+
+    constexpr void close_parent() {
+        parent().subtree_size = static_cast<uint32_t>(nodes.size() - parents.back());
+        parents.pop_back();
+    }
+
+    constexpr void add_node(const Node& node) {
+        const auto node_index = static_cast<uint32_t>(nodes.size());
+        nodes.push_back(node);
+        if (!parents.empty()) {
+            ++parent().children_count;
+        }
+        if (node.is_container() || node.is_key()) {
+            parents.push_back(node_index);
+        } else if (parent().is_key()) {
+            close_parent();
+        }
+    }
+
+    constexpr void add_value(const JsonValueType value_type, const JsonStaticValue value) {
+        add_node({JsonNodeType::value, value_type, value});
+    }
+
+    constexpr void add_string(const std::string_view value, const bool has_escapes, const bool is_key) {
+        // default options decode every string with escape sequences into the buffer of parser
+        JsonStaticString string{static_cast<uint32_t>(strings.size()), static_cast<uint32_t>(value.size())};
+        if (has_escapes) {
+            strings.insert(strings.end(), value.begin(), value.end());
+        } else {
+            string.offset = static_cast<uint32_t>(value.data() - json_data.data());
+        }
+        Node node(is_key ? JsonNodeType::key : JsonNodeType::value, JsonValueType::v_string, {.v_string = string});
+        node.escapes = has_escapes;
+        add_node(node);
+    }
+
+    constexpr void on_container_end() {
+        close_parent();
+        if (!parents.empty() && parent().is_key()) {
+            close_parent(); // container was value of key, so pop key
+        }
+    }
+
+public:
+    constexpr explicit JsonStaticBuilder(const std::string_view json_data_)
+        : json_data(json_data_), strings(json_data_.begin(), json_data_.end()) {}
+
+    [[nodiscard]] constexpr const auto& get_nodes() const { return nodes; }
+    [[nodiscard]] constexpr const auto& get_strings() const { return strings; }
+
+    // events of JsonSaxParser
+    constexpr void on_object_start() { add_node({JsonNodeType::object, JsonValueType::v_null, {}}); }
+    constexpr void on_array_start() { add_node({JsonNodeType::array, JsonValueType::v_null, {}}); }
+    constexpr void on_object_end() { on_container_end(); }
+    constexpr void on_array_end() { on_container_end(); }
+    constexpr void on_key(const std::string_view key, const bool has_escapes) { add_string(key, has_escapes, true); }
+
+    constexpr void on_string(const std::string_view value, const bool has_escapes) {
+        add_string(value, has_escapes, false);
+    }
+
+    constexpr void on_int(const int value) { add_value(JsonValueType::v_int, {.v_int = value}); }
+    constexpr void on_int64(const int64_t value) { add_value(JsonValueType::v_int64, {.v_int64 = value}); }
+    constexpr void on_uint64(const uint64_t value) { add_value(JsonValueType::v_uint64, {.v_uint64 = value}); }
+    constexpr void on_double(const double value) { add_value(JsonValueType::v_double, {.v_double = value}); }
+    constexpr void on_boolean(const bool value) { add_value(JsonValueType::v_boolean, {.v_boolean = value}); }
+    constexpr void on_null() { add_value(JsonValueType::v_null, {}); }
+};
+
+/**
+ * Nodes and strings table of a static tree
+ */
+template <typename Node, size_t NodesCount, size_t StringsSize>
+struct JsonStaticTape {
+    std::array<Node, NodesCount> nodes{};
+    std::array<char, StringsSize> strings{};
+};
+
+/**
+ * Result of the first pass: error code and index as JsonTree reports them, and sizes of the tables
+ */
+struct JsonStaticScan {
+    JsonTreeParseError error_code{JsonTreeParseError::no_error};
+    size_t index{0};
+    size_t nodes_count{0};
+    size_t strings_size{0};
+
+    [[nodiscard]] constexpr bool valid() const { return error_code == JsonTreeParseError::no_error; }
+};
+
+constexpr JsonStaticScan json_static_scan(const std::string_view json_data) {
+    JsonStaticBuilder<JsonStaticNode<void>> builder(json_data);
+    JsonSaxParser parser(json_data, builder);
+    parser.parse();
+    return {parser.get_error_code(), parser.get_index(), builder.get_nodes().size(), builder.get_strings().size()};
+}
+
+/**
+ * Second pass, nodes and strings are copied from the builder into tables of the sizes found by the first pass
+ */
+template <typename Node, size_t NodesCount, size_t StringsSize>
+constexpr JsonStaticTape<Node, NodesCount, StringsSize> json_static_build(const std::string_view json_data) {
+    JsonStaticBuilder<Node> builder(json_data);
+    JsonSaxParser parser(json_data, builder);
+    parser.parse();
+    JsonStaticTape<Node, NodesCount, StringsSize> tape;
+    std::copy(builder.get_nodes().begin(), builder.get_nodes().end(), tape.nodes.begin());
+    std::copy(builder.get_strings().begin(), builder.get_strings().end(), tape.strings.begin());
+    return tape;
+}
+
+/**
+ * Fails compilation of invalid json data, the error code and its index are shown as template arguments
+ */
+template <JsonTreeParseError ErrorCode, size_t Index>
+constexpr bool json_static_check() {
+    static_assert(ErrorCode == JsonTreeParseError::no_error, "invalid json data, see error code and index above");
+    return true;
+}
+
+/**
+ * Tree of json data known at compile time: JsonSaxParser runs in constant expressions with JsonStaticBuilder as
+ * its handler, nodes and strings are placed by the compiler into one constant table in read-only data. Nothing is
+ * parsed or allocated when the program runs. Nodes are JsonStaticNode, with the same accessors as JsonNode, which
+ * can be used also in constant expressions. Objects are searched by find() without hash index.
+ *
+ *     constexpr auto& config = json_static_tree<R"({"baud": 115200, "pins": [4, 5]})">;
+ *     constexpr auto baud = config.get_root()->find("baud")->get_key_value_node()->get_value_int();
+ */
+template <JsonLiteral Json>
+class JsonStaticTree {
+public:
+    using Node = JsonStaticNode<JsonStaticTree>;
+
+private:
+    static constexpr auto scan = json_static_scan(Json.view());
+    static_assert(json_static_check<scan.error_code, scan.index>());
+
+    static constexpr auto tape = json_static_build<Node, scan.nodes_count, scan.strings_size>(Json.view());
+
+public:
+    /**
+     * Json data as kept in the strings table, strings without escape sequences are its parts
+     */
+    [[nodiscard]] static constexpr std::string_view get_json_data() {
+        return {tape.strings.data(), Json.view().size()};
+    }
+    [[nodiscard]] static constexpr const Node* get_root() { return tape.nodes.data(); }
+    [[nodiscard]] static constexpr const auto& get_nodes() { return tape.nodes; }
+    [[nodiscard]] static constexpr const auto& get_strings() { return tape.strings; }
+    [[nodiscard]] static constexpr size_t size() { return tape.nodes.size(); }
+};
+
+template <JsonLiteral Json>
+inline constexpr JsonStaticTree<Json> json_static_tree{};
+
+#endif //__jsontree__jsontree_static_hpp
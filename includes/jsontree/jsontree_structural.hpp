@@ -0,0 +1,523 @@
+/*
+ * jsontree - JSON Parsing and library in C++20
+ * Copyright 2025 Marcin Markiewicz, marcin.kivrin@gmail.com
+ *
+ * This file is a part of jsontree project
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * Project: jsontree
+ *
+ */
+
+#ifndef __jsontree__jsontree_structural_hpp
+#define __jsontree__jsontree_structural_hpp
+
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "jsontree_chars.hpp"
+
+#if !defined(JSONTREE_DISABLE_SIMD) && (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+#define JSONTREE_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+#if !defined(JSONTREE_DISABLE_SIMD) && defined(__SSE2__)
+#define JSONTREE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+
+/**
+ * Stage 1 of parsing: index of structural positions.
+ *
+ * Input is classified in blocks of 64 bytes, every class is a bit mask where bit N describes byte N of the block.
+ * Masks are combined into positions of: {}[]:, outside strings, opening and closing quotes of strings, and first
+ * bytes of numbers and literals. Parser jumps from one position to the next instead of stepping over every byte.
+ */
+
+enum class JsonSimdLevel {
+    scalar,
+    sse42,
+    avx2,
+};
+
+struct JsonBlockMasks {
+    uint64_t quote{0};
+    uint64_t backslash{0};
+    uint64_t operators{0}; // {}[]:,
+    uint64_t whitespace{0};
+};
+
+constexpr size_t json_block_size = 64;
+
+inline JsonBlockMasks json_classify_block_scalar(const char* block) {
+    JsonBlockMasks masks{};
+    for (size_t i = 0; i < json_block_size; ++i) {
+        const uint64_t bit = uint64_t{1} << i;
+        switch (json_token_classes[static_cast<uint8_t>(block[i])]) {
+        case JsonTokenClass::string:
+            masks.quote |= bit;
+            break;
+        case JsonTokenClass::whitespace:
+            masks.whitespace |= bit;
+            break;
+        case JsonTokenClass::object_start:
+        case JsonTokenClass::object_end:
+        case JsonTokenClass::array_start:
+        case JsonTokenClass::array_end:
+        case JsonTokenClass::colon:
+        case JsonTokenClass::comma:
+            masks.operators |= bit;
+            break;
+        default:
+            if (block[i] == '\\') {
+                masks.backslash |= bit;
+            }
+            break;
+        }
+    }
+    return masks;
+}
+
+#ifdef JSONTREE_X86_SIMD
+
+__attribute__((target("sse4.2"))) inline uint64_t json_sse42_any_of(const __m128i* chunks, const __m128i set,
+                                                                     const int set_size) {
+    uint64_t mask = 0;
+    for (int i = 0; i < 4; ++i) {
+        const auto matches = _mm_cmpestrm(set, set_size, chunks[i], 16,
+                                          _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_BIT_MASK);
+        mask |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_cvtsi128_si32(matches))) << (i * 16);
+    }
+    return mask;
+}
+
+__attribute__((target("sse4.2"))) inline uint64_t json_sse42_equal(const __m128i* chunks, const char c) {
+    const auto value = _mm_set1_epi8(c);
+    uint64_t mask = 0;
+    for (int i = 0; i < 4; ++i) {
+        const auto matches = _mm_movemask_epi8(_mm_cmpeq_epi8(chunks[i], value));
+        mask |= static_cast<uint64_t>(static_cast<uint16_t>(matches)) << (i * 16);
+    }
+    return mask;
+}
+
+__attribute__((target("sse4.2"))) inline JsonBlockMasks json_classify_block_sse42(const char* block) {
+    const __m128i chunks[4]{
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(block)),
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16)),
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 32)),
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 48)),
+    };
+    const auto operators = _mm_setr_epi8('{', '}', '[', ']', ':', ',', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    const auto whitespaces = _mm_setr_epi8(' ', '\t', '\n', '\r', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    return {
+        .quote = json_sse42_equal(chunks, '"'),
+        .backslash = json_sse42_equal(chunks, '\\'),
+        .operators = json_sse42_any_of(chunks, operators, 6),
+        .whitespace = json_sse42_any_of(chunks, whitespaces, 4),
+    };
+}
+
+__attribute__((target("avx2"))) inline uint64_t json_avx2_equal(const __m256i lo, const __m256i hi, const char c) {
+    const auto value = _mm256_set1_epi8(c);
+    const auto lo_mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, value)));
+    const auto hi_mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, value)));
+    return lo_mask | static_cast<uint64_t>(hi_mask) << 32;
+}
+
+__attribute__((target("avx2"))) inline JsonBlockMasks json_classify_block_avx2(const char* block) {
+    const auto lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+    const auto hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32));
+    JsonBlockMasks masks{
+        .quote = json_avx2_equal(lo, hi, '"'),
+        .backslash = json_avx2_equal(lo, hi, '\\'),
+    };
+    for (const auto c : {'{', '}', '[', ']', ':', ','}) {
+        masks.operators |= json_avx2_equal(lo, hi, c);
+    }
+    for (const auto c : {' ', '\t', '\n', '\r'}) {
+        masks.whitespace |= json_avx2_equal(lo, hi, c);
+    }
+    return masks;
+}
+
+#endif
+
+inline JsonSimdLevel json_detect_simd_level() {
+#ifdef JSONTREE_X86_SIMD
+    static const auto level = [] {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return JsonSimdLevel::avx2;
+        }
+        if (__builtin_cpu_supports("sse4.2")) {
+            return JsonSimdLevel::sse42;
+        }
+        return JsonSimdLevel::scalar;
+    }();
+    return level;
+#else
+    return JsonSimdLevel::scalar;
+#endif
+}
+
+
+/**
+ * Turns block masks into structural positions, keeps string and escape state between blocks
+ */
+class JsonStructuralIndexer {
+    uint64_t prev_escaped{0}; // first byte of next block is escaped
+    uint64_t prev_in_string{0}; // all ones when block ended inside string
+    uint64_t prev_scalar{0}; // last byte of block was part of number or literal
+
+    static uint64_t prefix_xor(uint64_t bits) {
+        bits ^= bits << 1;
+        bits ^= bits << 2;
+        bits ^= bits << 4;
+        bits ^= bits << 8;
+        bits ^= bits << 16;
+        bits ^= bits << 32;
+        return bits;
+    }
+
+    uint64_t escaped(uint64_t backslash) {
+        uint64_t escaped = prev_escaped;
+        prev_escaped = 0;
+        backslash &= ~escaped; // escaped backslash does not escape next byte
+        while (backslash != 0) {
+            const uint64_t next = (backslash & -backslash) << 1;
+            backslash &= backslash - 1;
+            if (next == 0) {
+                prev_escaped = 1;
+            } else {
+                escaped |= next;
+                backslash &= ~next;
+            }
+        }
+        return escaped;
+    }
+
+public:
+    uint64_t next(const JsonBlockMasks& masks) {
+        const auto quote = masks.quote & ~escaped(masks.backslash);
+        const auto in_string = prefix_xor(quote) ^ prev_in_string; // opening quote in, closing quote out
+        prev_in_string = static_cast<uint64_t>(static_cast<int64_t>(in_string) >> 63);
+        const auto scalar = ~(masks.whitespace | masks.operators | quote | in_string);
+        const auto scalar_start = scalar & ~(scalar << 1 | prev_scalar);
+        prev_scalar = scalar >> 63;
+        return (masks.operators & ~in_string) | quote | scalar_start;
+    }
+};
+
+template <typename Classifier>
+void json_build_structural_index(const std::string_view data, std::vector<uint32_t>& positions,
+                                 Classifier&& classify) {
+    JsonStructuralIndexer indexer{};
+    const auto add_positions = [&](uint64_t structurals, const size_t base) {
+        while (structurals != 0) {
+            positions.push_back(static_cast<uint32_t>(base + std::countr_zero(structurals)));
+            structurals &= structurals - 1;
+        }
+    };
+    size_t base = 0;
+    for (; base + json_block_size <= data.size(); base += json_block_size) {
+        add_positions(indexer.next(classify(data.data() + base)), base);
+    }
+    if (base < data.size()) {
+        char block[json_block_size];
+        std::memset(block, ' ', json_block_size);
+        std::memcpy(block, data.data() + base, data.size() - base);
+        add_positions(indexer.next(classify(block)), base);
+    }
+}
+
+/**
+ * Fill positions with structural index of data, data must be shorter than 4 GiB
+ */
+inline void json_build_structural_index(const std::string_view data, std::vector<uint32_t>& positions,
+                                        const JsonSimdLevel level = json_detect_simd_level()) {
+    positions.clear();
+    positions.reserve(data.size() / 4);
+    switch (level) {
+#ifdef JSONTREE_X86_SIMD
+    case JsonSimdLevel::avx2:
+        json_build_structural_index(data, positions, json_classify_block_avx2);
+        return;
+    case JsonSimdLevel::sse42:
+        json_build_structural_index(data, positions, json_classify_block_sse42);
+        return;
+#endif
+    default:
+        json_build_structural_index(data, positions, json_classify_block_scalar);
+        return;
+    }
+}
+
+
+/**
+ * Call visitor with position of every operator ({}[]:,) outside of strings, in order, until it returns false
+ */
+template <typename Classifier, typename Visitor>
+void json_visit_operators(const std::string_view data, Visitor&& visitor, Classifier&& classify) {
+    JsonStructuralIndexer indexer{};
+    bool more = true;
+    const auto visit = [&](uint64_t operators, const size_t base) {
+        for (; operators != 0 && more; operators &= operators - 1) {
+            more = visitor(base + std::countr_zero(operators));
+        }
+    };
+    size_t base = 0;
+    for (; base + json_block_size <= data.size() && more; base += json_block_size) {
+        const auto masks = classify(data.data() + base);
+        visit(indexer.next(masks) & masks.operators, base);
+    }
+    if (base < data.size() && more) {
+        char block[json_block_size];
+        std::memset(block, ' ', json_block_size);
+        std::memcpy(block, data.data() + base, data.size() - base);
+        const auto masks = classify(block);
+        visit(indexer.next(masks) & masks.operators, base);
+    }
+}
+
+template <typename Visitor>
+void json_visit_operators(const std::string_view data, Visitor&& visitor,
+                          const JsonSimdLevel level = json_detect_simd_level()) {
+    switch (level) {
+#ifdef JSONTREE_X86_SIMD
+    case JsonSimdLevel::avx2:
+        return json_visit_operators(data, visitor, json_classify_block_avx2);
+    case JsonSimdLevel::sse42:
+        return json_visit_operators(data, visitor, json_classify_block_sse42);
+#endif
+    default:
+        return json_visit_operators(data, visitor, json_classify_block_scalar);
+    }
+}
+
+/**
+ * Split top level array into ranges for parallel parsing: commas are commas of the array which are at least
+ * min_range bytes apart. Returns position of the closing bracket of the array, data.size() if it is not found.
+ * Brackets are only counted, the ranges are checked by the parser.
+ */
+inline size_t json_find_array_boundaries(const std::string_view data, const size_t min_range,
+                                         std::vector<size_t>& commas,
+                                         const JsonSimdLevel level = json_detect_simd_level()) {
+    commas.clear();
+    size_t depth = 0;
+    size_t next_comma = min_range;
+    size_t end = data.size();
+    json_visit_operators(
+        data,
+        [&](const size_t position) {
+            switch (data[position]) {
+            case '[':
+            case '{':
+                ++depth;
+                break;
+            case ']':
+            case '}':
+                if (--depth == 0) {
+                    end = position;
+                    return false;
+                }
+                break;
+            case ',':
+                if (depth == 1 && position >= next_comma) {
+                    commas.push_back(position);
+                    next_comma = position + min_range;
+                }
+                break;
+            default:
+                break;
+            }
+            return true;
+        },
+        level);
+    return end;
+}
+
+/**
+ * Load 8 bytes as little endian word, so the first byte in memory is the lowest byte on every platform. Borrows of
+ * the word scans below go towards higher bytes, only the lowest matching byte is exact.
+ */
+inline uint64_t json_load_word_le(const char* bytes) {
+    uint64_t word;
+    std::memcpy(&word, bytes, sizeof(word));
+    if constexpr (std::endian::native == std::endian::big) {
+        uint64_t swapped = 0;
+        for (size_t i = 0; i < sizeof(word); ++i, word >>= 8) {
+            swapped = (swapped << 8) | (word & 0xFF);
+        }
+        word = swapped;
+    }
+    return word;
+}
+
+/**
+ * String scanning: position of the first quote or backslash at or after index, data.size() if there is none.
+ * Checks 16 bytes at a time with SSE2 (always present on x86-64) or 8 bytes at a time in a 64-bit word.
+ */
+constexpr size_t json_find_quote_or_backslash(const std::string_view data, size_t index) {
+    const auto size = data.size();
+    const auto bytes = data.data();
+    if (!std::is_constant_evaluated()) { // blocks are not read at compile time, see jsontree_static.hpp
+#ifdef JSONTREE_SSE2
+        const auto quotes = _mm_set1_epi8('"');
+        const auto backslashes = _mm_set1_epi8('\\');
+        for (; index + 16 <= size; index += 16) {
+            const auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + index));
+            const auto matches = _mm_or_si128(_mm_cmpeq_epi8(chunk, quotes), _mm_cmpeq_epi8(chunk, backslashes));
+            const auto mask = static_cast<uint32_t>(_mm_movemask_epi8(matches));
+            if (mask != 0) {
+                return index + std::countr_zero(mask);
+            }
+        }
+#else
+        constexpr uint64_t ones = 0x0101010101010101;
+        constexpr uint64_t highs = 0x8080808080808080;
+        for (; index + 8 <= size; index += 8) {
+            const auto word = json_load_word_le(bytes + index);
+            const auto quote = word ^ (ones * '"');
+            const auto backslash = word ^ (ones * '\\');
+            // high bit of the first zero byte is exact, bytes above it may be false positives
+            const auto mask = (((quote - ones) & ~quote) | ((backslash - ones) & ~backslash)) & highs;
+            if (mask != 0) {
+                return index + std::countr_zero(mask) / 8;
+            }
+        }
+#endif
+    }
+    for (; index < size; ++index) {
+        if (bytes[index] == '"' || bytes[index] == '\\') {
+            return index;
+        }
+    }
+    return size;
+}
+
+/**
+ * Position of the first byte which must be escaped in json string (quote, backslash or control character below
+ * 0x20) at or after index, data.size() if there is none. Used by JsonWriter, blocks are checked like in
+ * json_find_quote_or_backslash().
+ */
+inline size_t json_find_escaped_char(const std::string_view data, size_t index) {
+    const auto size = data.size();
+    const auto bytes = data.data();
+#ifdef JSONTREE_SSE2
+    const auto quotes = _mm_set1_epi8('"');
+    const auto backslashes = _mm_set1_epi8('\\');
+    const auto controls = _mm_set1_epi8(0x1F);
+    for (; index + 16 <= size; index += 16) {
+        const auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + index));
+        // unsigned chunk <= 0x1F when max(chunk, 0x1F) == 0x1F
+        const auto control = _mm_cmpeq_epi8(_mm_max_epu8(chunk, controls), controls);
+        const auto matches =
+            _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, quotes), _mm_cmpeq_epi8(chunk, backslashes)), control);
+        const auto mask = static_cast<uint32_t>(_mm_movemask_epi8(matches));
+        if (mask != 0) {
+            return index + std::countr_zero(mask);
+        }
+    }
+#else
+    constexpr uint64_t ones = 0x0101010101010101;
+    constexpr uint64_t highs = 0x8080808080808080;
+    for (; index + 8 <= size; index += 8) {
+        const auto word = json_load_word_le(bytes + index);
+        const auto quote = word ^ (ones * '"');
+        const auto backslash = word ^ (ones * '\\');
+        // bytes below 0x20 borrow in word - 0x20..., high bit of the first matching byte is exact
+        const auto mask =
+            (((quote - ones) & ~quote) | ((backslash - ones) & ~backslash) | ((word - ones * 0x20) & ~word)) & highs;
+        if (mask != 0) {
+            return index + std::countr_zero(mask) / 8;
+        }
+    }
+#endif
+    for (; index < size; ++index) {
+        const auto c = static_cast<uint8_t>(bytes[index]);
+        if (c == '"' || c == '\\' || c < 0x20) {
+            return index;
+        }
+    }
+    return size;
+}
+
+/**
+ * Position of the quote which closes string started at index (first byte after opening quote), data.size() if
+ * string is not closed. Backslash escapes the next byte, so runs of backslashes are consumed in pairs.
+ * has_escapes is set when string contains any escape sequence.
+ */
+constexpr size_t json_find_string_end(const std::string_view data, size_t index, bool& has_escapes) {
+    has_escapes = false;
+    while (true) {
+        index = json_find_quote_or_backslash(data, index);
+        if (index >= data.size() || data[index] == '"') {
+            return index;
+        }
+        has_escapes = true;
+        index += index + 1 < data.size() ? 2 : 1; // skip backslash and escaped byte
+    }
+}
+
+constexpr size_t json_find_string_end(const std::string_view data, const size_t index) {
+    bool has_escapes{};
+    return json_find_string_end(data, index, has_escapes);
+}
+
+/**
+ * Position of the first non whitespace byte at or after index. Pretty printed documents have long indentation
+ * runs, they are consumed 16 bytes at a time with SSE2 or 8 spaces at a time in a 64-bit word.
+ */
+constexpr size_t json_skip_whitespaces(const std::string_view data, size_t index) {
+    const auto size = data.size();
+    const auto bytes = data.data();
+    if (!std::is_constant_evaluated()) { // blocks are not read at compile time, see jsontree_static.hpp
+#ifdef JSONTREE_SSE2
+        for (; index + 16 <= size; index += 16) {
+            const auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + index));
+            const auto whitespaces = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\t'))),
+                _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('\n')), _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\r'))));
+            const auto mask = static_cast<uint32_t>(_mm_movemask_epi8(whitespaces));
+            if (mask != 0xFFFF) {
+                return index + std::countr_one(mask);
+            }
+        }
+#else
+        constexpr uint64_t spaces = 0x2020202020202020;
+        while (index < size && json_is_whitespace(bytes[index])) {
+            ++index;
+            uint64_t word;
+            while (index + 8 <= size && (std::memcpy(&word, bytes + index, sizeof(word)), word == spaces)) {
+                index += 8;
+            }
+        }
+#endif
+    }
+    while (index < size && json_is_whitespace(bytes[index])) {
+        ++index;
+    }
+    return index;
+}
+
+#endif //__jsontree__jsontree_structural_hpp
@@ -0,0 +1,135 @@
+/*
+ * jsontree - JSON Parsing and library in C++20
+ * Copyright 2025 Marcin Markiewicz, marcin.kivrin@gmail.com
+ *
+ * This file is a part of jsontree project
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * Project: jsontree
+ *
+ */
+
+#ifndef __jsontree__jsontree_thread_pool_hpp
+#define __jsontree__jsontree_thread_pool_hpp
+
+
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+/**
+ * Fixed set of threads used by parallel parsers.
+ *
+ * run() calls a job once on every worker, the calling thread is worker 0, and returns when all of them are done.
+ * Workers split the work themselves, usually by taking parts of it from an atomic counter. Threads sleep between
+ * jobs, so one pool is meant to be created once and shared by all batches.
+ */
+class JsonThreadPool {
+    std::vector<std::thread> threads{};
+    std::mutex mutex{};
+    std::mutex run_mutex{}; // one job at a time
+    std::condition_variable job_ready{};
+    std::condition_variable job_done{};
+    const std::function<void(size_t)>* job{nullptr};
+    size_t generation{0};
+    size_t running{0};
+    bool stopping{false};
+
+    void work(size_t worker);
+
+public:
+    /**
+     * Pool with given number of workers including the calling thread, 0 means number of hardware threads
+     */
+    explicit JsonThreadPool(size_t workers = 0);
+
+    JsonThreadPool(const JsonThreadPool& other) = delete;
+    JsonThreadPool(JsonThreadPool&& other) noexcept = delete;
+
+    ~JsonThreadPool();
+
+    [[nodiscard]] auto size() const { return threads.size() + 1; }
+
+    void run(const std::function<void(size_t)>& f);
+};
+
+inline JsonThreadPool::JsonThreadPool(size_t workers) {
+    if (workers == 0) {
+        workers = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads.reserve(workers - 1);
+    for (size_t worker = 1; worker < workers; ++worker) {
+        threads.emplace_back(&JsonThreadPool::work, this, worker);
+    }
+}
+
+inline JsonThreadPool::~JsonThreadPool() {
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    job_ready.notify_all();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+inline void JsonThreadPool::work(const size_t worker) {
+    size_t seen_generation = 0;
+    while (true) {
+        const std::function<void(size_t)>* f;
+        {
+            std::unique_lock lock(mutex);
+            job_ready.wait(lock, [&] { return stopping || generation != seen_generation; });
+            if (stopping) {
+                return;
+            }
+            seen_generation = generation;
+            f = job;
+        }
+        (*f)(worker);
+        {
+            std::lock_guard lock(mutex);
+            --running;
+        }
+        job_done.notify_one();
+    }
+}
+
+inline void JsonThreadPool::run(const std::function<void(size_t)>& f) {
+    std::lock_guard run_lock(run_mutex);
+    if (threads.empty()) {
+        f(0);
+        return;
+    }
+    {
+        std::lock_guard lock(mutex);
+        job = &f;
+        running = threads.size();
+        ++generation;
+    }
+    job_ready.notify_all();
+    f(0);
+    std::unique_lock lock(mutex);
+    job_done.wait(lock, [&] { return running == 0; });
+    job = nullptr;
+}
+
+
+#endif //__jsontree__jsontree_thread_pool_hpp
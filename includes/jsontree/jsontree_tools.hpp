@@ -71,6 +71,18 @@ inline std::string get_json_parse_error_message(const JsonTreeParseError& error_
         return "trailing comma";
     case JsonTreeParseError::unexpected_end_of_data:
         return "unexpected end of data";
+    case JsonTreeParseError::out_of_memory:
+        return "out of memory";
+    case JsonTreeParseError::number_out_of_range:
+        return "number out of range";
+    case JsonTreeParseError::invalid_escape_sequence:
+        return "invalid escape sequence";
+    case JsonTreeParseError::stopped_by_handler:
+        return "stopped by handler";
+    case JsonTreeParseError::value_type_mismatch:
+        return "value type mismatch";
+    case JsonTreeParseError::too_many_items:
+        return "too many items";
     default:
         return "unknown error";
     }
@@ -87,6 +99,12 @@ inline void print_json_value(std::ostream& out, const JsonNode* node) {
     case JsonValueType::v_int:
         out << "INT|" << node->get_value_int();
         break;
+    case JsonValueType::v_int64:
+        out << "INT64|" << node->get_value_int64();
+        break;
+    case JsonValueType::v_uint64:
+        out << "UINT64|" << node->get_value_uint64();
+        break;
     case JsonValueType::v_double:
         out << "DOUBLE|" << node->get_value_double();
         break;
@@ -0,0 +1,356 @@
+/*
+ * jsontree - JSON Parsing and library in C++20
+ * Copyright 2025 Marcin Markiewicz, marcin.kivrin@gmail.com
+ *
+ * This file is a part of jsontree project
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * Project: jsontree
+ *
+ */
+
+#ifndef __jsontree__jsontree_writer_hpp
+#define __jsontree__jsontree_writer_hpp
+
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "jsontree.hpp"
+
+
+struct JsonWriteOptions {
+    bool pretty{false}; // new line for every child, indented by indent spaces per level
+    uint8_t indent{2};
+    bool raw_strings{false}; // strings with escapes keep raw text of json data (decode_escapes = false)
+};
+
+/**
+ * Writer of json text from nodes of JsonTree, JsonDocument or any other tape.
+ *
+ * Text is appended to a growable buffer owned by the writer, or to a caller supplied buffer which is never
+ * grown: when it is full writing stops and truncated() is set. Tape is walked in document order with a stack
+ * of open containers, there is no recursion. Numbers are formatted with std::to_chars, doubles use the shortest
+ * form which reads back to the same value and keep ".0" so they are read back as doubles. Strings are copied
+ * in runs found by json_find_escaped_char(), only quotes, backslashes and control characters are escaped.
+ */
+class JsonWriter {
+    struct Container {
+        uint32_t remaining; // children which are not written yet
+        bool is_object;
+    };
+
+    JsonWriteOptions options;
+    std::string storage{};
+    char* buffer{nullptr};
+    size_t size{0};
+    size_t capacity{0};
+    bool fixed{false};
+    bool truncated_{false};
+    std::vector<Container> containers{};
+
+    bool reserve(size_t count);
+    void put(char c) { buffer[size++] = c; }
+
+    void put(const std::string_view text) {
+        std::memcpy(buffer + size, text.data(), text.size());
+        size += text.size();
+    }
+
+    bool write_text(std::string_view text);
+    bool write_new_line(size_t depth);
+    bool write_value(const JsonNode* node);
+    bool write_separator(bool first);
+
+public:
+    /**
+     * Writer with growable buffer, buffer keeps its memory after clear()
+     */
+    explicit JsonWriter(const JsonWriteOptions& options_ = {}) : options(options_) {}
+
+    /**
+     * Writer to caller supplied buffer, buffer must outlive the writer
+     */
+    JsonWriter(char* buffer_, const size_t buffer_size, const JsonWriteOptions& options_ = {})
+        : options(options_), buffer(buffer_), capacity(buffer_size), fixed(true) {}
+
+    JsonWriter(const JsonWriter& other) = delete;
+    JsonWriter& operator=(const JsonWriter& other) = delete;
+
+    /**
+     * Append node with its subtree, returns false when fixed buffer is too small
+     */
+    bool write(const JsonNode* node);
+
+    /**
+     * Append root of parsed tree, strings of tree parsed without decode_escapes are written as they are
+     */
+    bool write(const JsonTree& tree);
+
+    /**
+     * Append text which is already json, e.g. unchanged part of json data, it is not checked
+     */
+    bool write_raw(const std::string_view json_text) { return write_text(json_text); }
+
+    /**
+     * Append string in quotes, with escapes when raw is false
+     */
+    bool write_string(std::string_view value, bool raw = false);
+
+    void clear() {
+        size = 0;
+        truncated_ = false;
+    }
+
+    void set_options(const JsonWriteOptions& options_) { options = options_; }
+
+    [[nodiscard]] auto get_options() const { return options; }
+    [[nodiscard]] std::string_view view() const { return {buffer, size}; }
+    [[nodiscard]] auto data() const { return buffer; }
+    [[nodiscard]] auto get_size() const { return size; }
+    [[nodiscard]] auto truncated() const { return truncated_; }
+};
+
+inline bool JsonWriter::reserve(const size_t count) {
+    if (size + count <= capacity) [[likely]] {
+        return true;
+    }
+    if (fixed) {
+        truncated_ = true;
+        return false;
+    }
+    storage.resize(std::max({size + count, capacity * 2, size_t{256}}));
+    buffer = storage.data();
+    capacity = storage.size();
+    return true;
+}
+
+inline bool JsonWriter::write_text(const std::string_view text) {
+    if (!reserve(text.size())) {
+        return false;
+    }
+    put(text);
+    return true;
+}
+
+inline bool JsonWriter::write_new_line(const size_t depth) {
+    const auto spaces = depth * options.indent;
+    if (!reserve(spaces + 1)) {
+        return false;
+    }
+    put('\n');
+    std::memset(buffer + size, ' ', spaces);
+    size += spaces;
+    return true;
+}
+
+inline bool JsonWriter::write_string(const std::string_view value, const bool raw) {
+    if (!reserve(value.size() + 2)) {
+        return false;
+    }
+    put('"');
+    if (raw) {
+        put(value);
+        put('"');
+        return true;
+    }
+    size_t index = 0;
+    while (true) {
+        const auto escaped = json_find_escaped_char(value, index);
+        // reserved room is for the string without escapes, each escape takes at most 5 more bytes
+        if (escaped == value.size()) {
+            put(value.substr(index));
+            break;
+        }
+        put(value.substr(index, escaped - index));
+        if (!reserve(value.size() - escaped + 6)) {
+            return false;
+        }
+        const auto c = static_cast<uint8_t>(value[escaped]);
+        switch (c) {
+        case '"':
+            put("\\\"");
+            break;
+        case '\\':
+            put("\\\\");
+            break;
+        case '\b':
+            put("\\b");
+            break;
+        case '\f':
+            put("\\f");
+            break;
+        case '\n':
+            put("\\n");
+            break;
+        case '\r':
+            put("\\r");
+            break;
+        case '\t':
+            put("\\t");
+            break;
+        default: {
+            constexpr std::string_view hex_digits{"0123456789abcdef"};
+            put("\\u00");
+            put(hex_digits[c >> 4]);
+            put(hex_digits[c & 0x0F]);
+            break;
+        }
+        }
+        index = escaped + 1;
+    }
+    put('"');
+    return true;
+}
+
+inline bool JsonWriter::write_value(const JsonNode* node) {
+    // longest number is a double in exponent form, ".0" makes room for the suffix
+    constexpr size_t number_size = 32;
+    // raw text of lazy numbers is written as is only when valid json, the lenient ones are formatted below
+    if (node->has_raw_number() && json_is_number_strict(node->get_raw_number())) {
+        return write_text(node->get_raw_number());
+    }
+    switch (node->get_value_type()) {
+    case JsonValueType::v_string:
+        return write_string(node->get_value_string(), options.raw_strings && node->has_escapes());
+    case JsonValueType::v_boolean:
+        return write_text(node->get_value_boolean() ? "true" : "false");
+    case JsonValueType::v_null:
+        return write_text("null");
+    default:
+        break;
+    }
+    // numbers are formatted in place, near the end of fixed buffer in a local buffer and copied if they fit
+    char digits[number_size];
+    const auto in_place = (!fixed && reserve(number_size)) || size + number_size <= capacity;
+    const auto out = in_place ? buffer + size : digits;
+    std::to_chars_result result{};
+    switch (node->get_value_type()) {
+    case JsonValueType::v_int:
+        result = std::to_chars(out, out + number_size, node->get_value_int());
+        break;
+    case JsonValueType::v_int64:
+        result = std::to_chars(out, out + number_size, node->get_value_int64());
+        break;
+    case JsonValueType::v_uint64:
+        result = std::to_chars(out, out + number_size, node->get_value_uint64());
+        break;
+    default: {
+        const auto number = node->get_value_double();
+        if (!std::isfinite(number)) {
+            return write_text("null"); // json has no infinity and nan
+        }
+        result = std::to_chars(out, out + number_size, number);
+        if (std::find_if(out, result.ptr, [](const char c) { return c == '.' || c == 'e'; }) == result.ptr) {
+            *result.ptr++ = '.';
+            *result.ptr++ = '0';
+        }
+        break;
+    }
+    }
+    if (!in_place) {
+        return write_text({out, static_cast<size_t>(result.ptr - out)});
+    }
+    size = result.ptr - buffer;
+    return true;
+}
+
+inline bool JsonWriter::write_separator(const bool first) {
+    if (!first && !write_text(",")) {
+        return false;
+    }
+    return !options.pretty || write_new_line(containers.size());
+}
+
+inline bool JsonWriter::write(const JsonNode* node) {
+    if (node == nullptr) {
+        return false;
+    }
+    containers.clear();
+    const auto end = node + node->get_subtree_size();
+    bool after_key = false;
+    bool first = true; // next node is the first child of its container
+    for (; node != end; ++node) {
+        if (!containers.empty() && !after_key && !write_separator(first)) {
+            return false;
+        }
+        after_key = false;
+        first = false;
+        if (node->is_key()) {
+            if (!write_string(node->get_key_name(), options.raw_strings && node->has_escapes()) ||
+                !write_text(options.pretty ? ": " : ":")) {
+                return false;
+            }
+            after_key = true;
+            continue;
+        }
+        if (node->is_container()) {
+            if (!write_text(node->is_object() ? "{" : "[")) {
+                return false;
+            }
+            if (node->get_children_count() > 0) {
+                containers.push_back({node->get_children_count(), node->is_object()});
+                first = true;
+                continue;
+            }
+            if (!write_text(node->is_object() ? "}" : "]")) {
+                return false;
+            }
+        } else if (!write_value(node)) {
+            return false;
+        }
+        // value is complete, close containers whose last child it was
+        while (!containers.empty() && --containers.back().remaining == 0) {
+            const auto is_object = containers.back().is_object;
+            containers.pop_back();
+            if ((options.pretty && !write_new_line(containers.size())) || !write_text(is_object ? "}" : "]")) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+inline bool JsonWriter::write(const JsonTree& tree) {
+    if (!tree.valid()) {
+        return false;
+    }
+    const auto raw_strings = options.raw_strings;
+    options.raw_strings = !tree.get_options().decode_escapes;
+    const auto result = write(tree.get_root());
+    options.raw_strings = raw_strings;
+    return result;
+}
+
+/**
+ * Json text of node with its subtree
+ */
+inline std::string json_write(const JsonNode* node, const JsonWriteOptions& options = {}) {
+    JsonWriter writer(options);
+    writer.write(node);
+    return std::string(writer.view());
+}
+
+inline std::string json_write(const JsonTree& tree, const JsonWriteOptions& options = {}) {
+    JsonWriter writer(options);
+    writer.write(tree);
+    return std::string(writer.view());
+}
+
+#endif //__jsontree__jsontree_writer_hpp
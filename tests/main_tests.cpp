@@ -26,6 +26,23 @@
 #include "test_simple.cpp"
 #include "test_embedded.cpp"
 #include "test_errors.cpp"
+#include "test_arena.cpp"
+#include "test_structural.cpp"
+#include "test_find.cpp"
+#include "test_query.cpp"
+#include "test_cursor.cpp"
+#include "test_sax.cpp"
+#include "test_chunks.cpp"
+#include "test_mmap.cpp"
+#include "test_image.cpp"
+#include "test_lines.cpp"
+#include "test_parallel.cpp"
+#include "test_parser.cpp"
+#include "test_cache.cpp"
+#include "test_bind.cpp"
+#include "test_static.cpp"
+#include "test_writer.cpp"
+#include "test_edit.cpp"
 
 
 int main() {
@@ -57,15 +74,94 @@ int main() {
     test_bad_float_extra_minus();
     test_bad_float_plus();
     test_bad_int();
+    test_unknown_token();
+    test_vertical_tab_is_not_whitespace();
+    test_number_out_of_range();
+    test_incomplete_number();
+    test_invalid_escape_sequence();
 
     test_parse_error_empty_object();
     test_parse_object_with_simple_value();
     test_parse_object_with_many_simple_values();
     test_parse_empty_array();
     test_parse_array_with_simple_values();
+    test_parse_array_with_wide_integers();
+    test_parse_lazy_numbers();
+    test_parse_escaped_strings();
     test_parse_embedded_object();
     test_parse_array_of_objects();
     test_parse_array_of_mixed_items();
+    test_parse_nested_siblings();
+
+    test_arena_static_buffer();
+    test_arena_static_buffer_too_small();
+    test_arena_heap_fallback();
+    test_arena_reuse();
+
+    test_structural_index_positions();
+    test_structural_index_block_boundaries();
+    test_structural_index_parse_same_as_bytes();
+    test_find_string_end();
+    test_find_escaped_char();
+    test_skip_whitespaces();
+
+    test_find_in_small_object();
+    test_find_in_big_object();
+
+    test_query_pointer();
+    test_query_path();
+
+    test_cursor_find();
+    test_cursor_for_each();
+    test_cursor_errors();
+
+    test_sax_events();
+    test_sax_same_errors_as_tree();
+    test_sax_stopped_by_handler();
+
+    test_chunks_same_as_whole_data();
+    test_chunks_errors();
+    test_chunks_sax_events();
+
+    test_mmap_file_tree();
+    test_mmap_file_errors();
+
+    test_image_same_as_tree();
+    test_image_file();
+    test_image_errors();
+
+    test_lines_parse();
+    test_lines_parallel_parse();
+
+    test_parallel_array_boundaries();
+    test_parallel_same_as_serial();
+    test_parallel_errors();
+
+    test_parser_reuse();
+    test_parser_document_move();
+
+    test_cache_hits_and_evictions();
+    test_cache_max_bytes();
+    test_cache_threads();
+
+    test_bind_struct();
+    test_bind_perfect_hash();
+    test_bind_errors();
+
+    test_static_same_as_tree();
+    test_static_read_only();
+    test_static_errors();
+    test_static_numbers();
+
+    test_writer_minified_and_pretty();
+    test_writer_escapes();
+    test_writer_round_trip();
+    test_writer_lenient_lazy_numbers();
+    test_writer_fixed_buffer();
+
+    test_edit_values();
+    test_edit_insert_and_erase();
+    test_edit_without_spans();
 
 
     std::cout << "================" << std::endl;
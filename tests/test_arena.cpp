@@ -0,0 +1,89 @@
+/*
+* jsontree - JSON Parsing and library in C++20
+ * Copyright 2025 Marcin Markiewicz, marcin.kivrin@gmail.com
+ *
+ * This file is a part of jsontree project
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * Project: jsontree
+ *
+ */
+
+#include <iostream>
+#include <cassert>
+#include "jsontree.hpp"
+
+
+void test_arena_static_buffer() {
+    std::cout << "Test arena with static buffer...";
+    alignas(JsonNode) static std::byte buffer[JsonNodeArena::buffer_size_for(8)];
+    JsonNodeArena arena(buffer, sizeof(buffer));
+    JsonTree tree(R"({"k1": [1, 2, 3]})", arena);
+    assert(tree.parse());
+    assert(tree.valid());
+    assert(tree.get_nodes().size() == 6);
+    assert(!arena.empty());
+    for (auto const node : tree.get_nodes()) {
+        assert(reinterpret_cast<const std::byte*>(node) >= buffer);
+        assert(reinterpret_cast<const std::byte*>(node) < buffer + sizeof(buffer));
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_arena_static_buffer_too_small() {
+    std::cout << "Test arena with too small static buffer...";
+    alignas(JsonNode) static std::byte buffer[JsonNodeArena::buffer_size_for(4)];
+    JsonNodeArena arena(buffer, sizeof(buffer));
+    JsonTree tree(R"([1, 2, 3, 4, 5, 6])", arena);
+    assert(!tree.parse());
+    assert(!tree.valid());
+    assert(tree.get_error_code() == JsonTreeParseError::out_of_memory);
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_arena_heap_fallback() {
+    std::cout << "Test arena with static buffer and heap fallback...";
+    alignas(JsonNode) static std::byte buffer[JsonNodeArena::buffer_size_for(2)];
+    JsonNodeArena arena(buffer, sizeof(buffer), true, 2);
+    JsonTree tree(R"([1, 2, 3, 4, 5, 6])", arena);
+    assert(tree.parse());
+    assert(tree.valid());
+    assert(tree.get_nodes().size() == 7);
+    int expected = 1;
+    for (auto const item : tree.get_root()->get_children()) {
+        assert(item->get_value_int() == expected++);
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_arena_reuse() {
+    std::cout << "Test arena reused by many trees...";
+    JsonNodeArena arena(3);
+    {
+        JsonTree tree(R"({"k1": "v1", "k2": "v2"})", arena);
+        assert(tree.parse());
+        assert(arena.size() == 5);
+    }
+    assert(arena.empty());
+    {
+        JsonTree tree(R"(["v1"])", arena);
+        assert(tree.parse());
+        assert(tree.get_root()->is_array());
+        assert(tree.get_root()->get_children().front()->get_value_string() == "v1");
+        assert(arena.size() == 2);
+    }
+    assert(arena.empty());
+    std::cout << "PASSED" << std::endl;
+}
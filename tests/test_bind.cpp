@@ -0,0 +1,165 @@
+/*
+* jsontree - JSON Parsing and library in C++20
+ * Copyright 2025 Marcin Markiewicz, marcin.kivrin@gmail.com
+ *
+ * This file is a part of jsontree project
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * Project: jsontree
+ *
+ */
+
+#include <iostream>
+#include <cassert>
+#include <array>
+#include <optional>
+#include <string>
+#include <vector>
+#include "jsontree.hpp"
+#include "jsontree_bind.hpp"
+
+
+struct BindItem {
+    std::string name{};
+    int count{};
+};
+
+template <>
+struct JsonFields<BindItem> {
+    static constexpr std::tuple fields{json_field("name", &BindItem::name), json_field("count", &BindItem::count)};
+};
+
+struct BindSettings {
+    std::string title{};
+    int level{-1};
+    uint64_t id{};
+    double ratio{};
+    float scale{};
+    bool enabled{};
+    std::optional<int> limit{};
+    std::array<int, 3> position{};
+    std::vector<BindItem> items{};
+    BindItem main_item{};
+    std::vector<std::vector<double>> matrix{};
+};
+
+template <>
+struct JsonFields<BindSettings> {
+    static constexpr std::tuple fields{
+        json_field("title", &BindSettings::title),
+        json_field("level", &BindSettings::level),
+        json_field("id", &BindSettings::id),
+        json_field("ratio", &BindSettings::ratio),
+        json_field("scale", &BindSettings::scale),
+        json_field("enabled", &BindSettings::enabled),
+        json_field("limit", &BindSettings::limit),
+        json_field("position", &BindSettings::position),
+        json_field("items", &BindSettings::items),
+        json_field("main item", &BindSettings::main_item),
+        json_field("matrix", &BindSettings::matrix),
+    };
+};
+
+void test_bind_struct() {
+    std::cout << "Test bind json to struct...";
+    const std::string_view json_data = R"( {
+        "title": "Eryndor \"Nightblade\" é",
+        "id": 18446744073709551615,
+        "unknown": {"a": [1, {"b": "]"}], "c": null},
+        "ratio": -2.5e-3,
+        "scale": 1.5,
+        "enabled": true,
+        "limit": null,
+        "position": [1, 2, 3],
+        "items": [{"name": "sword", "count": 1, "extra": [true]}, {"count": 20, "name": "arrow"}],
+        "main item": {"name": "shield"},
+        "matrix": [[1, 2.5], [], [-3]]
+    } )";
+    BindSettings settings;
+    settings.limit = 5;
+    const auto result = json_bind(json_data, settings);
+    assert(result.valid());
+    assert(settings.title == "Eryndor \"Nightblade\" é");
+    assert(settings.level == -1); // missing key
+    assert(settings.id == 18446744073709551615u);
+    assert(settings.ratio == -2.5e-3);
+    assert(settings.scale == 1.5f);
+    assert(settings.enabled);
+    assert(!settings.limit.has_value());
+    assert((settings.position == std::array<int, 3>{1, 2, 3}));
+    assert(settings.items.size() == 2);
+    assert(settings.items[0].name == "sword" && settings.items[0].count == 1);
+    assert(settings.items[1].name == "arrow" && settings.items[1].count == 20);
+    assert(settings.main_item.name == "shield" && settings.main_item.count == 0);
+    assert((settings.matrix == std::vector<std::vector<double>>{{1, 2.5}, {}, {-3}}));
+    // fields are found by perfect hash built at compile time
+    static_assert(JsonStructBinding<BindSettings>::find("matrix") == 10);
+    static_assert(JsonStructBinding<BindSettings>::find("title") == 0);
+    static_assert(JsonStructBinding<BindSettings>::find("titles") == JsonStructBinding<BindSettings>::npos);
+    static_assert(JsonStructBinding<BindSettings>::find("") == JsonStructBinding<BindSettings>::npos);
+    std::vector<BindItem> items;
+    assert(json_bind(R"([{"name": "a"}, {"name": "b", "count": 2}])", items).valid());
+    assert(items.size() == 2 && items[1].count == 2);
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_bind_perfect_hash() {
+    std::cout << "Test bind perfect hash...";
+    constexpr std::array<std::string_view, 30> names{
+        "a", "b", "c", "d", "e", "f", "g", "h", "i", "j", "k", "l", "m", "n", "o", "p", "q", "r", "s", "t",
+        "u", "v", "w", "x", "y", "z", "name", "names", "value", "values"};
+    constexpr auto hash = json_find_perfect_hash(names);
+    static_assert(hash.size >= 2 * names.size());
+    std::vector<bool> used(hash.size);
+    for (const auto name : names) {
+        const auto slot = JsonPerfectHash::slot(name, hash.seed, hash.size);
+        assert(!used[slot]);
+        used[slot] = true;
+    }
+    static_assert(json_find_perfect_hash(std::array<std::string_view, 2>{"a", "a"}).size == 0);
+    std::cout << "PASSED" << std::endl;
+}
+
+void assert_bind_error(const std::string_view json_data, const JsonTreeParseError error_code, const size_t index) {
+    BindSettings settings;
+    const auto result = json_bind(json_data, settings);
+    assert(result.error_code == error_code);
+    assert(result.index == index);
+}
+
+void test_bind_errors() {
+    std::cout << "Test bind errors...";
+    assert_bind_error("", JsonTreeParseError::empty_json_data, 0);
+    assert_bind_error("[]", JsonTreeParseError::value_type_mismatch, 0);
+    assert_bind_error(R"({"level": "1"})", JsonTreeParseError::value_type_mismatch, 10);
+    assert_bind_error(R"({"level": 1.5})", JsonTreeParseError::value_type_mismatch, 10);
+    assert_bind_error(R"({"level": 2147483648})", JsonTreeParseError::number_out_of_range, 10);
+    assert_bind_error(R"({"level": 1-2})", JsonTreeParseError::invalid_number_literal, 11);
+    assert_bind_error(R"({"enabled": null})", JsonTreeParseError::value_type_mismatch, 12);
+    assert_bind_error(R"({"enabled": nope})", JsonTreeParseError::unexpected_literal, 12);
+    assert_bind_error(R"({"position": [1, 2, 3, 4]})", JsonTreeParseError::too_many_items, 23);
+    assert_bind_error(R"({"position": [1, 2,]})", JsonTreeParseError::trailing_comma, 19);
+    assert_bind_error(R"({"position": [1 2]})", JsonTreeParseError::missing_comma, 16);
+    assert_bind_error(R"({"title": "a\qb"})", JsonTreeParseError::invalid_escape_sequence, 12);
+    assert_bind_error(R"({"title": "ab)", JsonTreeParseError::unexpected_end_of_data, 13);
+    assert_bind_error(R"({"level": 1,})", JsonTreeParseError::trailing_comma, 12);
+    assert_bind_error(R"({"level" 1})", JsonTreeParseError::missing_colon, 9);
+    assert_bind_error(R"({level: 1})", JsonTreeParseError::key_must_be_string, 1);
+    assert_bind_error(R"({"unknown": [1, 2})", JsonTreeParseError::end_of_object_mismatch, 17);
+    assert_bind_error(R"({"unknown": [1, 2)", JsonTreeParseError::unexpected_end_of_data, 17);
+    assert_bind_error(R"({"level": 1} x)", JsonTreeParseError::unexpected_node, 13);
+    assert_bind_error(R"({"level": 1)", JsonTreeParseError::unexpected_end_of_data, 11);
+    std::cout << "PASSED" << std::endl;
+}
@@ -0,0 +1,129 @@
+/*
+* jsontree - JSON Parsing and library in C++20
+ * Copyright 2025 Marcin Markiewicz, marcin.kivrin@gmail.com
+ *
+ * This file is a part of jsontree project
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * Project: jsontree
+ *
+ */
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <thread>
+#include <vector>
+#include "jsontree.hpp"
+#include "jsontree_cache.hpp"
+
+
+void test_cache_hits_and_evictions() {
+    std::cout << "Test cache hits and evictions...";
+    assert(json_content_hash("") != json_content_hash(" "));
+    assert(json_content_hash(R"({"a": 1})") != json_content_hash(R"({"a": 2})"));
+    JsonParseCache cache({.max_entries = 2});
+    std::string json_data = R"({"name": "Eryndor", "level": 7})";
+    const auto first = cache.parse(json_data);
+    assert(first->valid() && first->get_root()->find("level")->get_key_value_node()->get_value_int() == 7);
+    // document keeps its own copy of json data
+    json_data[0] = ' ';
+    assert(first->get_json_data()[0] == '{');
+    json_data[0] = '{';
+    const auto second = cache.parse(json_data);
+    assert(second == first);
+    auto metrics = cache.get_metrics();
+    assert(metrics.hits == 1 && metrics.misses == 1 && metrics.entries == 1);
+    assert(metrics.bytes == json_data.size() + first->get_document().get_nodes().size() * sizeof(JsonNode) +
+                                first->get_document().get_strings().capacity());
+    // data of the same length is compared by bytes
+    const auto other = cache.parse(R"({"name": "Eryndor", "level": 8})");
+    assert(other != first && other->get_root()->find("level")->get_key_value_node()->get_value_int() == 8);
+    // third document evicts the least recently used one
+    assert(cache.parse(json_data) == first);
+    assert(cache.parse("[1, 2, 3]")->get_root()->get_children_count() == 3);
+    metrics = cache.get_metrics();
+    assert(metrics.evictions == 1 && metrics.entries == 2);
+    assert(cache.parse(json_data) == first);
+    assert(cache.get_metrics().hits == 3);
+    // invalid documents are not cached
+    const auto invalid = cache.parse("[1, 2");
+    assert(!invalid->valid() && invalid->get_error_code() == JsonTreeParseError::unexpected_end_of_data);
+    assert(cache.parse("[1, 2") != invalid);
+    cache.clear();
+    metrics = cache.get_metrics();
+    assert(metrics.entries == 0 && metrics.bytes == 0 && metrics.misses == 5);
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_cache_max_bytes() {
+    std::cout << "Test cache max bytes...";
+    const std::string small = "[1]";
+    const std::string big = "[" + std::string(900, ' ') + "1]";
+    JsonParseCache cache({.max_bytes = 1024});
+    const auto first = cache.parse(small);
+    cache.parse(big);
+    assert(cache.get_metrics().entries == 1 && cache.get_metrics().evictions == 1);
+    // documents bigger than the cache are not cached
+    JsonParseCache tiny({.max_bytes = 16});
+    tiny.parse(big);
+    assert(tiny.get_metrics().entries == 0);
+    // evicted document lives while it is held
+    assert(first->get_root()->get_children().front()->get_value_int() == 1);
+    // decoded strings and key indexes are counted, indexes before they are built by lookups
+    std::string indexed = "{";
+    for (int key = 0; key < 20; ++key) {
+        indexed += (key > 0 ? ", \"k\\t" : "\"k\\t") + std::to_string(key) + "\": 1";
+    }
+    indexed += "}";
+    JsonParseCache indexed_cache;
+    const auto document = indexed_cache.parse(indexed);
+    const auto size = document->get_size();
+    const auto& strings = document->get_document().get_strings();
+    assert(strings.size() > 20 * 3);
+    assert(size == indexed.size() + 41 * sizeof(JsonNode) + strings.capacity() + JsonKeyIndex::memory_size(20));
+    assert(document->get_root()->find("k\t7")->get_key_value_node()->get_value_int() == 1);
+    assert(document->get_size() == size && indexed_cache.get_metrics().bytes == size);
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_cache_threads() {
+    std::cout << "Test cache used by many threads...";
+    std::vector<std::string> documents;
+    for (int i = 0; i < 8; ++i) {
+        std::string json_data = "{";
+        for (int key = 0; key < 20; ++key) {
+            json_data += (key > 0 ? ", \"" : "\"") + std::to_string(key) + "\": " + std::to_string(key * i);
+        }
+        documents.push_back(json_data + "}");
+    }
+    JsonParseCache cache({.max_entries = 6});
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < 2000; ++i) {
+                const auto n = (i * 7 + t) % 8;
+                const auto document = cache.parse(documents[n]);
+                // big objects build key index on the first lookup, from any thread
+                assert(document->get_root()->find("13")->get_key_value_node()->get_value_int() == 13 * n);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    const auto metrics = cache.get_metrics();
+    assert(metrics.hits + metrics.misses == 8000 && metrics.entries <= 6);
+    std::cout << "PASSED" << std::endl;
+}
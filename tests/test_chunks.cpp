@@ -0,0 +1,138 @@
+/*
+* jsontree - JSON Parsing and library in C++20
+ * Copyright 2025 Marcin Markiewicz, marcin.kivrin@gmail.com
+ *
+ * This file is a part of jsontree project
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * Project: jsontree
+ *
+ */
+
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <vector>
+#include "jsontree.hpp"
+
+
+void assert_same_tree(const JsonTree& tree, const JsonTree& chunked_tree) {
+    assert(tree.valid() == chunked_tree.valid());
+    assert(tree.get_error_code() == chunked_tree.get_error_code());
+    assert(tree.get_index() == chunked_tree.get_index());
+    if (!tree.valid()) {
+        return;
+    }
+    assert(tree.get_nodes().size() == chunked_tree.get_nodes().size());
+    auto it = chunked_tree.get_nodes().begin();
+    for (auto const node : tree.get_nodes()) {
+        assert(node->get_type() == (*it)->get_type());
+        assert(node->get_value_type() == (*it)->get_value_type());
+        assert(node->get_children_count() == (*it)->get_children_count());
+        assert(node->get_subtree_size() == (*it)->get_subtree_size());
+        assert(node->has_escapes() == (*it)->has_escapes());
+        assert(node->has_raw_number() == (*it)->has_raw_number());
+        if (node->is_string() || node->has_raw_number()) {
+            assert(node->get_value_string() == (*it)->get_value_string());
+        } else if (node->is_double()) {
+            assert(node->get_value_double() == (*it)->get_value_double());
+        } else if (node->is_integer()) {
+            assert(node->get_value_uint64() == (*it)->get_value_uint64());
+        }
+        ++it;
+    }
+}
+
+/**
+ * Feed data in two chunks split at every position, chunks are overwritten after feed()
+ */
+void assert_same_tree_for_all_splits(const std::string_view json_data, const JsonTreeParseOptions& options = {}) {
+    JsonTree tree(json_data);
+    tree.parse(options);
+    for (size_t split = 0; split <= json_data.size(); ++split) {
+        JsonTree chunked_tree;
+        chunked_tree.set_options(options);
+        for (const auto chunk : {json_data.substr(0, split), json_data.substr(split)}) {
+            std::string buffer(chunk);
+            chunked_tree.feed(buffer);
+            buffer.assign(buffer.size(), '#');
+        }
+        chunked_tree.finish();
+        assert_same_tree(tree, chunked_tree);
+    }
+}
+
+void test_chunks_same_as_whole_data() {
+    std::cout << "Test chunked parse same as whole data...";
+    const std::string_view json_data =
+        R"( {"k1": [12, -3.5e+2, true, null, "a\"b\\", "é😀"], "k2": {"k\n3": 18446744073709551615}} )";
+    assert_same_tree_for_all_splits(json_data);
+    assert_same_tree_for_all_splits(json_data, {.lazy_numbers = true});
+    assert_same_tree_for_all_splits(json_data, {.decode_escapes = false});
+    // one byte at a time
+    JsonTree tree(json_data);
+    JsonTree chunked_tree;
+    assert(tree.parse());
+    for (const auto c : json_data) {
+        assert(chunked_tree.feed(std::string_view(&c, 1)));
+    }
+    assert(chunked_tree.finish());
+    assert_same_tree(tree, chunked_tree);
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_chunks_errors() {
+    std::cout << "Test chunked parse errors...";
+    for (const auto* json_data : {"", "  ", "123", "[1, 2", "[\"abc", "[\"abc\\", "[tru", "[tru e]", "[1.5e", "[1e999]",
+                                  R"(["a\q"])", "[1,2,]", R"({"a" 1})", "[1] [2]", "[12a]"}) {
+        assert_same_tree_for_all_splits(json_data);
+    }
+    JsonTree chunked_tree;
+    assert(!chunked_tree.feed("[1, @"));
+    assert(!chunked_tree.feed("]"));
+    assert(!chunked_tree.finish());
+    assert(chunked_tree.get_error_code() == JsonTreeParseError::unknown_token);
+    assert(chunked_tree.get_index() == 4);
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_chunks_sax_events() {
+    std::cout << "Test chunked sax parser events...";
+    struct Handler {
+        std::vector<std::string> strings{};
+        int sum{0};
+
+        void on_object_start() {}
+        void on_object_end() {}
+        void on_array_start() {}
+        void on_array_end() {}
+        void on_key(const std::string_view key) { strings.emplace_back(key); }
+        void on_string(const std::string_view value) { strings.emplace_back(value); }
+        void on_int(const int value) { sum += value; }
+        void on_int64(int64_t) {}
+        void on_uint64(uint64_t) {}
+        void on_double(double) {}
+        void on_boolean(bool) {}
+        void on_null() {}
+    } handler{};
+    JsonSaxParser parser(handler);
+    for (const auto* chunk : {R"({"na)", R"(me": "va\)", R"("lue", "n": [1)", "23, 4", "56]", "}"}) {
+        assert(parser.feed(chunk));
+    }
+    assert(parser.finish());
+    assert((handler.strings == std::vector<std::string>{"name", "va\"lue", "n"}));
+    assert(handler.sum == 579);
+    std::cout << "PASSED" << std::endl;
+}
@@ -0,0 +1,138 @@
+/*
+* jsontree - JSON Parsing and library in C++20
+ * Copyright 2025 Marcin Markiewicz, marcin.kivrin@gmail.com
+ *
+ * This file is a part of jsontree project
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * Project: jsontree
+ *
+ */
+
+#include <iostream>
+#include <cassert>
+#include <string>
+#include "jsontree.hpp"
+#include "jsontree_cursor.hpp"
+
+
+void test_cursor_find() {
+    std::cout << "Test cursor find values...";
+    const JsonDocumentView document(R"({
+        "skipped": {"a": [1, {"b": "}]"}], "c": "\"{["},
+        "route": "/api/v1",
+        "user": {"id": 12345678901, "name": "Ann\u00e9", "admin": false, "tags": [null, 1.5, "x"]},
+        "k\"ey": 7
+    })");
+    const auto root = document.get_root();
+    assert(root.valid() && root.is_object());
+    JsonNode node;
+    assert(document.find("route").get_node(node) == JsonTreeParseError::no_error);
+    assert(node.is_string() && node.get_value_string() == "/api/v1" && !node.has_escapes());
+    const auto user = root.find("user");
+    assert(user.is_object());
+    assert(user.find("id").get_node(node) == JsonTreeParseError::no_error);
+    assert(node.is_int64() && node.get_value_int64() == 12345678901);
+    assert(user.find("name").get_node(node) == JsonTreeParseError::no_error);
+    assert(node.has_escapes() && node.get_value_string() == R"(Ann\u00e9)");
+    std::vector<char> decoded{};
+    assert(json_decode_string(node.get_value_string(), decoded) == node.get_value_string().size());
+    assert(std::string_view(decoded.data(), decoded.size()) == "Ann\xC3\xA9");
+    assert(user.find("admin").get_node(node) == JsonTreeParseError::no_error);
+    assert(node.is_boolean() && !node.get_value_boolean());
+    assert(user.find("tags").at(0).is_null());
+    assert(user.find("tags").at(1).get_node(node, true) == JsonTreeParseError::no_error);
+    assert(node.has_raw_number() && node.get_value_double() == 1.5);
+    assert(user.find("tags").at(2).get_raw() == R"("x")");
+    assert(root.find("skipped").get_raw() == R"({"a": [1, {"b": "}]"}], "c": "\"{["})");
+    assert(root.find("k\"ey").is_number());
+    // missing values are not errors
+    const auto missing = user.find("tags").at(3);
+    assert(!missing.valid() && missing.get_error_code() == JsonTreeParseError::no_error);
+    assert(!root.find("missing").find("deeper").valid());
+    assert(!root.find("route").find("x").valid());
+    assert(!root.at(0).valid());
+    assert(root.find("user").get_node(node) == JsonTreeParseError::unexpected_node);
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_cursor_for_each() {
+    std::cout << "Test cursor for each...";
+    const JsonDocumentView document(R"([{"a": 1, "b": [2, 3]}, 4, "five", [], {}])");
+    size_t items = 0;
+    assert(document.get_root().for_each_item([&items](const JsonCursor&) { items++; }) ==
+        JsonTreeParseError::no_error);
+    assert(items == 5);
+    std::string keys{};
+    assert(document.at(0).for_each_member([&keys](const std::string_view key, const JsonCursor& value) {
+        keys += key;
+        assert(value.valid());
+    }) == JsonTreeParseError::no_error);
+    assert(keys == "ab");
+    size_t empty_items = 0;
+    document.at(3).for_each_item([&empty_items](const JsonCursor&) { empty_items++; });
+    document.at(4).for_each_member([&empty_items](std::string_view, const JsonCursor&) { empty_items++; });
+    assert(empty_items == 0);
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_cursor_errors() {
+    std::cout << "Test cursor errors...";
+    struct Case {
+        const char* json_data;
+        JsonTreeParseError error_code;
+        size_t index;
+    };
+    for (const auto& [json_data, error_code, index] : {
+             Case{"  ", JsonTreeParseError::empty_json_data, 2},
+             Case{R"({"a" 1, "x": 2})", JsonTreeParseError::missing_colon, 5},
+             Case{R"({"a": 1 "x": 2})", JsonTreeParseError::missing_comma, 8},
+             Case{R"({"a": 1, "b": 2,})", JsonTreeParseError::trailing_comma, 16},
+             Case{R"({a: 1})", JsonTreeParseError::key_must_be_string, 1},
+             Case{R"({"a": tru, "x": 1})", JsonTreeParseError::unexpected_literal, 6},
+             Case{R"({"a": 1-2, "x": 1})", JsonTreeParseError::invalid_number_literal, 7},
+             Case{R"({"a": [1, {"b": 2}, "x": 1})", JsonTreeParseError::end_of_object_mismatch, 26},
+             Case{R"({"a": [1, {"b": 2})", JsonTreeParseError::unexpected_end_of_data, 18},
+             Case{R"({"a": "abc)", JsonTreeParseError::unexpected_end_of_data, 10},
+             Case{R"({"a": @, "x": 1})", JsonTreeParseError::unknown_token, 6},
+             Case{R"({"a": -, "x": 1})", JsonTreeParseError::invalid_number_literal, 7},
+             Case{R"({"a": 1e999, "x": 1})", JsonTreeParseError::number_out_of_range, 11},
+             Case{R"({"a": [1, {"b": 2]}, "x": 1})", JsonTreeParseError::end_of_array_mismatch, 17},
+             Case{R"({"a": [}, "x": 1})", JsonTreeParseError::end_of_object_mismatch, 7},
+             Case{R"({"a": [1, [-]], "x": 1})", JsonTreeParseError::invalid_number_literal, 12},
+             Case{R"({"a": [nul], "x": 1})", JsonTreeParseError::unexpected_literal, 7},
+             Case{R"({"a": [1, @], "x": 1})", JsonTreeParseError::unknown_token, 10},
+         }) {
+        const auto cursor = JsonDocumentView(json_data).find("x");
+        assert(!cursor.valid());
+        assert(cursor.get_error_code() == error_code);
+        assert(cursor.get_index() == index);
+        // errors propagate through navigation
+        assert(cursor.find("y").at(1).get_error_code() == error_code);
+    }
+    JsonNode node;
+    assert(JsonDocumentView("[1e999]").at(0).get_node(node) == JsonTreeParseError::number_out_of_range);
+    assert(JsonDocumentView("[-, 1]").at(1).get_error_code() == JsonTreeParseError::invalid_number_literal);
+    // separators in skipped containers are not checked
+    assert(JsonDocumentView(R"([[1 2,, 3], {"a" "b"}, 4])").at(2).get_node(node) == JsonTreeParseError::no_error);
+    assert(node.get_value_int() == 4);
+    // bracket types are matched past the inline part of skip stack
+    std::string deep = "[" + std::string(300, '[') + std::string(300, ']') + ", 5]";
+    assert(JsonDocumentView(deep).at(1).get_node(node) == JsonTreeParseError::no_error && node.get_value_int() == 5);
+    deep[310] = '}';
+    assert(JsonDocumentView(deep).at(1).get_error_code() == JsonTreeParseError::end_of_object_mismatch);
+    assert(JsonDocumentView(deep).at(1).get_index() == 310);
+    std::cout << "PASSED" << std::endl;
+}
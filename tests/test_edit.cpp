@@ -0,0 +1,121 @@
+/*
+* jsontree - JSON Parsing and library in C++20
+ * Copyright 2025 Marcin Markiewicz, marcin.kivrin@gmail.com
+ *
+ * This file is a part of jsontree project
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * Project: jsontree
+ *
+ */
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <string_view>
+#include "jsontree.hpp"
+#include "jsontree_edit.hpp"
+
+
+void test_edit_values() {
+    std::cout << "Test edit values...";
+    const std::string_view json_data = R"( {"name": "first", "list": [1, 2, 3], "nested": {"a": {"b": [true]}}} )";
+    JsonTree tree(json_data);
+    assert(tree.parse());
+    const auto root = tree.get_root();
+    JsonEditor editor(tree);
+    // without edits json data is copied
+    assert(editor.empty());
+    assert(json_write(editor) == R"({"name": "first", "list": [1, 2, 3], "nested": {"a": {"b": [true]}}})");
+    assert(editor.set_value(root->find("name"), JsonNode(std::string_view{"se\"cond"})));
+    assert(json_write(editor) == R"({"name":"se\"cond","list":[1, 2, 3],"nested":{"a": {"b": [true]}}})");
+    assert(editor.dirty(root) && !editor.dirty(root->find("list")->get_key_value_node()));
+    const auto b = root->find("nested")->get_key_value_node()->find("a")->get_key_value_node()->find("b");
+    assert(editor.set_json(b->get_key_value_node()->get_children().front(), R"({"c": null})"));
+    assert(json_write(editor) == R"({"name":"se\"cond","list":[1, 2, 3],"nested":{"a":{"b":[{"c": null}]}}})");
+    assert(editor.set_value(root->find("nested"), JsonNode(2.0)));
+    assert(json_write(editor) == R"({"name":"se\"cond","list":[1, 2, 3],"nested":2.0})");
+    editor.clear();
+    assert(editor.empty() && json_write(editor) == json_data.substr(1, json_data.size() - 2));
+    // nodes of other trees are not edited
+    JsonTree other_tree(json_data);
+    assert(other_tree.parse());
+    assert(!editor.set_value(other_tree.get_root()->find("name"), JsonNode(1)));
+    assert(!editor.set_value(nullptr, JsonNode(1)));
+    // spans of sibling dirty containers are found by one scan
+    JsonTree lists_tree(R"({"x": [[1, 2], {"k": [3, 4]}], "y": "s"})");
+    assert(lists_tree.parse());
+    const auto lists = lists_tree.get_root()->find("x")->get_key_value_node();
+    JsonEditor lists_editor(lists_tree);
+    assert(lists_editor.set_value(lists->get_children().front()->get_children().back(), JsonNode(5)));
+    assert(lists_editor.erase(lists->get_children().back()->find("k")->get_key_value_node()->get_children().front()));
+    assert(json_write(lists_editor) == R"({"x":[[1,5],{"k":[4]}],"y":"s"})");
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_edit_insert_and_erase() {
+    std::cout << "Test edit insert and erase...";
+    const std::string_view json_data = "{\n  \"a\": 1,\n  \"b\": [10, 20, 30],\n  \"c\": {\"d\": 4}\n}";
+    JsonTree tree(json_data);
+    assert(tree.parse());
+    const auto root = tree.get_root();
+    const auto list = root->find("b")->get_key_value_node();
+    JsonEditor editor(tree);
+    assert(editor.erase(list->get_children().front()));
+    assert(editor.erase(root, "a"));
+    assert(editor.insert(root, "e\n", JsonNode(5)));
+    assert(editor.insert_json(root->find("c")->get_key_value_node(), "f", "[]"));
+    assert(json_write(editor) == R"({"b":[20,30],"c":{"d":4,"f":[]},"e\n":5})");
+    // inserted key is replaced and erased, erased key comes back
+    assert(editor.insert(root, "e\n", JsonNode(6)));
+    assert(editor.erase(root, "e\n"));
+    assert(!editor.erase(root, "none"));
+    assert(editor.insert(root, "a", JsonNode(7)));
+    assert(editor.erase(root->find("c")->get_key_value_node()));
+    assert(!editor.erase(root));
+    assert(json_write(editor) == R"({"a":7,"b":[20,30]})");
+    const auto written = json_write(editor);
+    JsonTree written_tree(written);
+    assert(written_tree.parse() && written_tree.get_nodes().size() == 7);
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_edit_without_spans() {
+    std::cout << "Test edit without spans in json data...";
+    // parser accepts doubled comma, so children can not be found by commas and are written from nodes
+    JsonTree tree(R"([1,, {"a": "x\ty"}, 3])");
+    assert(tree.parse());
+    JsonEditor editor(tree);
+    assert(editor.set_value(tree.get_root()->get_children().back(), JsonNode(4)));
+    assert(json_write(editor) == R"([1,{"a":"x\ty"},4])");
+    // dirty container without spans, its clean sibling is still copied
+    JsonTree nested_tree(R"({"a": [1,, [2, 3]], "b": {"c": 1}})");
+    assert(nested_tree.parse());
+    const auto nested = nested_tree.get_root()->find("a")->get_key_value_node();
+    JsonEditor nested_editor(nested_tree);
+    assert(nested_editor.set_value(nested->get_children().back()->get_children().back(), JsonNode(4)));
+    assert(json_write(nested_editor) == R"({"a":[1,[2,4]],"b":{"c": 1}})");
+    // dirty container inside container without spans is written from nodes too
+    assert(nested_editor.erase(nested->get_children().front()));
+    assert(json_write(nested_editor) == R"({"a":[[2,4]],"b":{"c": 1}})");
+    // tree parsed from chunks has no json data
+    JsonTree chunked_tree;
+    chunked_tree.feed(R"({"k": [1, )");
+    chunked_tree.feed(R"("2"], "l": true})");
+    assert(chunked_tree.finish());
+    JsonEditor chunked_editor(chunked_tree);
+    assert(chunked_editor.erase(chunked_tree.get_root(), "l"));
+    assert(json_write(chunked_editor) == R"({"k":[1,"2"]})");
+    std::cout << "PASSED" << std::endl;
+}
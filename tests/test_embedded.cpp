@@ -110,3 +110,29 @@ void test_parse_array_of_mixed_items() {
     assert(tree.get_root()->get_children().back()->get_value_int() == 123);
     std::cout << "PASSED" << std::endl;
 }
+
+void test_parse_nested_siblings() {
+    std::cout << "Test siblings after nested containers...";
+    JsonTree tree(R"([[1, [2, 3]], {"k1": {"k1.1": [4]}, "k2": 5}, 6])");
+    assert(tree.parse());
+    assert(tree.valid());
+    assert(tree.get_nodes().size() == 15);
+    const auto root = tree.get_root();
+    assert(root->get_subtree_size() == 15);
+    assert(root->get_children().size() == 3);
+    auto it = root->get_children().begin();
+    assert((*it)->is_array());
+    assert((*it)->get_subtree_size() == 5);
+    assert((*it)->get_children().back()->get_children().back()->get_value_int() == 3);
+    ++it;
+    assert((*it)->is_object());
+    assert((*it)->get_children().size() == 2);
+    assert((*it)->get_children().front()->get_key_name() == "k1");
+    assert((*it)->get_children().back()->get_key_name() == "k2");
+    assert((*it)->get_children().back()->get_key_value_node()->get_value_int() == 5);
+    ++it;
+    assert((*it)->get_value_int() == 6);
+    ++it;
+    assert(it == root->get_children().end());
+    std::cout << "PASSED" << std::endl;
+}
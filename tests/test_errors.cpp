@@ -271,3 +271,66 @@ void test_not_closed_array() {
     assert(tree.get_error_code() == JsonTreeParseError::unexpected_end_of_data);
     std::cout << "PASSED" << std::endl;
 }
+
+void test_unknown_token() {
+    std::cout << "Test unknown token...";
+    JsonTree tree("[1, @]");
+    assert(!tree.parse());
+    assert(!tree.valid());
+    assert(tree.get_error_code() == JsonTreeParseError::unknown_token);
+    assert(tree.get_index() == 4);
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_vertical_tab_is_not_whitespace() {
+    std::cout << "Test vertical tab and form feed are not whitespaces...";
+    JsonTree tree("[1,\v2]");
+    assert(!tree.parse());
+    assert(tree.get_error_code() == JsonTreeParseError::unknown_token);
+    assert(tree.get_index() == 3);
+    JsonTree tree_form_feed("\f[1]");
+    assert(!tree_form_feed.parse());
+    assert(tree_form_feed.get_error_code() == JsonTreeParseError::unknown_token);
+    assert(tree_form_feed.get_index() == 0);
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_number_out_of_range() {
+    std::cout << "Test number out of range...";
+    for (const auto* json_data : {"[18446744073709551616]", "[-9223372036854775809]", "[1e999]", "[-1e999]"}) {
+        JsonTree tree(json_data);
+        assert(!tree.parse());
+        assert(!tree.valid());
+        assert(tree.get_error_code() == JsonTreeParseError::number_out_of_range);
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_incomplete_number() {
+    std::cout << "Test incomplete number...";
+    for (const auto* json_data : {"[-]", "[1e]", "[1e+]", "[-, 1]", "[1e.5]", "[-e5]", "[1e5.]"}) {
+        JsonTree tree(json_data);
+        assert(!tree.parse());
+        assert(!tree.valid());
+        assert(tree.get_error_code() == JsonTreeParseError::invalid_number_literal);
+        JsonTree lazy_tree(json_data);
+        assert(!lazy_tree.parse({.lazy_numbers = true}));
+        assert(lazy_tree.get_error_code() == JsonTreeParseError::invalid_number_literal);
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_invalid_escape_sequence() {
+    std::cout << "Test invalid escape sequence...";
+    for (const auto* json_data : {R"(["ab\q"])", R"(["ab\u12G4"])", R"(["ab\ud83d"])", R"(["ab\ude00x"])",
+                                  R"(["ab\ud83d\u0041"])", R"(["ab\u12"])"}) {
+        JsonTree tree(json_data);
+        assert(!tree.parse());
+        assert(!tree.valid());
+        assert(tree.get_error_code() == JsonTreeParseError::invalid_escape_sequence);
+        assert(tree.get_index() == 4);
+        JsonTree raw_tree(json_data);
+        assert(raw_tree.parse({.decode_escapes = false}));
+    }
+    std::cout << "PASSED" << std::endl;
+}
@@ -0,0 +1,66 @@
+/*
+* jsontree - JSON Parsing and library in C++20
+ * Copyright 2025 Marcin Markiewicz, marcin.kivrin@gmail.com
+ *
+ * This file is a part of jsontree project
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * Project: jsontree
+ *
+ */
+
+#include <iostream>
+#include <cassert>
+#include <string>
+#include "jsontree.hpp"
+
+
+void test_find_in_small_object() {
+    std::cout << "Test find key in small object...";
+    JsonTree tree(R"({"name": "Eryndor", "age": 34, "k\"1": {"inner": 1}, "name": "duplicate"})");
+    assert(tree.parse());
+    const auto root = tree.get_root();
+    assert(root->find("age")->get_key_value_node()->get_value_int() == 34);
+    assert(root->find("name")->get_key_value_node()->get_value_string() == "Eryndor");
+    assert(root->find("k\"1")->get_key_value_node()->is_object());
+    assert(root->find("inner") == nullptr);
+    assert(root->find("k\"1")->get_key_value_node()->find("inner") != nullptr);
+    assert(root->find("missing") == nullptr);
+    assert(root->find("age")->get_key_value_node()->find("age") == nullptr);
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_find_in_big_object() {
+    std::cout << "Test find key in big object...";
+    std::string json_data = "{";
+    for (int i = 0; i < 500; ++i) {
+        json_data += "\"key" + std::to_string(i) + "\": [" + std::to_string(i) + "], ";
+    }
+    json_data += R"("key7": "duplicate", "empty": {}})";
+    JsonTree tree(json_data);
+    assert(tree.parse());
+    const auto root = tree.get_root();
+    for (int i = 0; i < 500; ++i) {
+        const auto key = root->find("key" + std::to_string(i));
+        assert(key != nullptr);
+        assert(key->get_key_value_node()->get_children().front()->get_value_int() == i);
+    }
+    // the first of duplicated keys is found, same as in small objects
+    assert(root->find("key7")->get_key_value_node()->is_array());
+    assert(root->find("empty")->get_key_value_node()->find("key1") == nullptr);
+    assert(root->find("key500") == nullptr);
+    assert(root->find("") == nullptr);
+    std::cout << "PASSED" << std::endl;
+}
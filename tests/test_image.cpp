@@ -0,0 +1,194 @@
+/*
+* jsontree - JSON Parsing and library in C++20
+ * Copyright 2025 Marcin Markiewicz, marcin.kivrin@gmail.com
+ *
+ * This file is a part of jsontree project
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * Project: jsontree
+ *
+ */
+#include <iostream>
+#include <cassert>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include "jsontree.hpp"
+#include "jsontree_image.hpp"
+#include "jsontree_writer.hpp"
+
+
+void test_image_same_as_tree() {
+    std::cout << "Test image same as tree...";
+    std::string json_data = R"({"name": "Eryndor", "escaped": "a\"b\u00e9", "numbers": [1, -2, 3.5, 4294967296, )"
+                            R"(18446744073709551615, 1e300], "flags": [true, false, null], "empty": {}, "list": [)";
+    for (int i = 0; i < 20; ++i) {
+        json_data += (i > 0 ? ", " : "") + std::string(R"({"id": )") + std::to_string(i) + R"(, "name": "item"})";
+    }
+    json_data += R"(], "big": {)";
+    for (int i = 0; i < 40; ++i) {
+        json_data += (i > 0 ? ", " : "") + std::string("\"key") + std::to_string(i) + "\": " + std::to_string(i);
+    }
+    json_data += "}}";
+    for (const auto lazy_numbers : {false, true}) {
+        JsonTree tree(json_data);
+        assert(tree.parse({.lazy_numbers = lazy_numbers}));
+        auto image_data = json_image(tree);
+        // lazy numbers of source tree are left as they are
+        const auto source_numbers = tree.get_root()->find("numbers")->get_key_value_node();
+        assert(source_numbers->get_children().front()->has_raw_number() == lazy_numbers);
+        const auto image_size = image_data.size();
+        JsonImage image(std::move(image_data));
+        assert(image.valid());
+        assert(image.size() == tree.get_nodes().size());
+        assert(json_write(image.get_root()) == json_write(tree.get_root()));
+        // numbers are stored decoded
+        const auto numbers = image.get_root()->find("numbers")->get_key_value_node();
+        assert(!numbers->get_children().front()->has_raw_number());
+        assert(numbers->get_children().back()->get_value_double() == 1e300);
+        assert(image.get_root()->find("escaped")->get_key_value_node()->get_value_string() == "a\"b\xc3\xa9");
+        // big object is searched by key index
+        assert(image.get_root()->find("big")->get_key_value_node()->find("key33")->get_key_value_node()
+                   ->get_value_int() == 33);
+        assert(image.get_root()->find("big")->get_key_value_node()->find("key40") == nullptr);
+        // names of list items are stored once, big object has 128 slots of key index
+        const auto index_size = 128 * sizeof(JsonKeyIndex::Slot);
+        assert(image_size < sizeof(JsonImageHeader) + image.size() * sizeof(JsonNode) + index_size +
+                                json_data.size() / 4);
+    }
+    // image of a subtree
+    JsonTree tree(json_data);
+    assert(tree.parse());
+    const auto flags = tree.get_root()->find("flags")->get_key_value_node();
+    JsonImage image(json_image(flags));
+    assert(image.valid() && json_write(image.get_root()) == "[true,false,null]");
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_image_file() {
+    std::cout << "Test image file...";
+    const auto path = (std::filesystem::temp_directory_path() / "jsontree_test_image.bin").string();
+    const std::string_view json_data = R"({"name": "Eryndor", "properties": [1, 2, "three"]})";
+    {
+        JsonTree tree(json_data);
+        assert(tree.parse());
+        assert(json_save_image(tree, path.c_str()));
+    }
+    // file is not changed by loading, so it can be loaded again
+    for (int i = 0; i < 2; ++i) {
+        JsonImage image(path.c_str());
+        assert(image.valid());
+        assert(image.get_root()->find("name")->get_key_value_node()->get_value_string() == "Eryndor");
+        const auto properties = image.get_root()->find("properties")->get_key_value_node();
+        assert(properties->get_children_count() == 3);
+        assert(properties->get_children().back()->get_value_string() == "three");
+        // strings point into the image, which is mapped read only
+        const auto data = image.get_file().get_data();
+        const auto name = image.get_root()->find("name")->get_key_name();
+        assert(name.data() > data.data() && name.data() < data.data() + data.size());
+        assert(image.get_file().get_writable_data() == nullptr || !image.get_file().is_mapped());
+    }
+    std::filesystem::remove(path);
+    JsonImage missing("/nonexistent/jsontree.bin");
+    assert(missing.get_error_code() == JsonImageError::file_error);
+    assert(missing.get_file_error_code() == JsonMappedFileError::open_failed);
+    assert(missing.get_root() == nullptr);
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_image_errors() {
+    std::cout << "Test image errors...";
+    JsonTree tree(R"({"name": "Eryndor", "properties": [1, 2, 3]})");
+    assert(tree.parse());
+    const auto image_data = json_image(tree);
+    const auto load = [&](const auto& change) {
+        auto data = image_data;
+        change(data);
+        const JsonImage image(std::move(data));
+        assert(image.valid() == (image.get_root() != nullptr));
+        return image.get_error_code();
+    };
+    assert(load([](auto&) {}) == JsonImageError::no_error);
+    assert(load([](auto& data) { data.clear(); }) == JsonImageError::invalid_header);
+    assert(load([](auto& data) { data[0] = 'J'; }) == JsonImageError::invalid_header);
+    assert(load([](auto& data) { data.pop_back(); }) == JsonImageError::invalid_header);
+    assert(load([](auto& data) { ++data[offsetof(JsonImageHeader, version)]; }) ==
+           JsonImageError::unsupported_format);
+    assert(load([](auto& data) { ++data[offsetof(JsonImageHeader, node_size)]; }) ==
+           JsonImageError::unsupported_format);
+    // nodes are patched through the header layout written by json_image()
+    JsonImageHeader header{};
+    std::memcpy(&header, image_data.data(), sizeof(header));
+    const auto node_field = [&](const size_t node, const size_t offset) {
+        return header.nodes_offset + node * sizeof(JsonNode) + offset;
+    };
+    // fields of JsonNode: type at 0, children_count at 4, subtree_size at 8, value at 16
+    static_assert(sizeof(JsonNode) == 32);
+    // subtree size of root
+    assert(load([&](auto& data) { ++data[node_field(0, 8)]; }) == JsonImageError::invalid_nodes);
+    // children count of array
+    assert(load([&](auto& data) { ++data[node_field(4, 4)]; }) == JsonImageError::invalid_nodes);
+    // type of key
+    assert(load([&](auto& data) { data[node_field(1, 0)] = static_cast<char>(JsonNodeType::value); }) ==
+           JsonImageError::invalid_nodes);
+    // offset of string
+    assert(load([&](auto& data) { data[node_field(2, 16 + 7)] = 1; }) == JsonImageError::invalid_nodes);
+    // string outside of the strings pool
+    assert(load([&](auto& data) { data[node_field(2, 16)] -= 8; }) == JsonImageError::invalid_nodes);
+    // string without relative value
+    assert(load([&](auto& data) { data[node_field(2, 2)] = 0; }) == JsonImageError::invalid_nodes);
+    // key index of big object
+    std::string big_json = R"({"n": {"a": 1})";
+    for (int i = 1; i < 20; ++i) {
+        big_json += ", \"k" + std::to_string(i) + "\": " + std::to_string(i);
+    }
+    big_json += "}";
+    JsonTree big_tree(big_json);
+    assert(big_tree.parse());
+    const auto big_image = json_image(big_tree);
+    JsonImageHeader big_header{};
+    std::memcpy(&big_header, big_image.data(), sizeof(big_header));
+    assert(big_header.indexes_size == 64 * sizeof(JsonKeyIndex::Slot));
+    const auto load_big = [&](const auto& change) {
+        auto data = big_image;
+        change(data);
+        return JsonImage(std::move(data)).get_error_code();
+    };
+    assert(load_big([](auto&) {}) == JsonImageError::no_error);
+    // offsets of slots point to key nodes, 0 is empty slot
+    const auto change_slots = [&](auto& data, const auto& change) {
+        for (auto position = big_header.indexes_offset + 4; position < big_header.strings_offset; position += 8) {
+            uint32_t offset{};
+            std::memcpy(&offset, data.data() + position, sizeof(offset));
+            offset = change(offset);
+            std::memcpy(data.data() + position, &offset, sizeof(offset));
+        }
+    };
+    // slot which points to value node
+    assert(load_big([&](auto& data) {
+               change_slots(data, [](const uint32_t offset) { return offset == 1 ? 2u : offset; });
+           }) == JsonImageError::invalid_nodes);
+    // slot which points to key of nested object
+    assert(load_big([&](auto& data) {
+               change_slots(data, [](const uint32_t offset) { return offset == 1 ? 3u : offset; });
+           }) == JsonImageError::invalid_nodes);
+    // table without empty slot
+    assert(load_big([&](auto& data) {
+               change_slots(data, [](const uint32_t offset) { return offset == 0 ? 1u : offset; });
+           }) == JsonImageError::invalid_nodes);
+    assert(get_json_image_error_message(JsonImageError::invalid_nodes) == "invalid nodes");
+    std::cout << "PASSED" << std::endl;
+}
@@ -0,0 +1,119 @@
+/*
+* jsontree - JSON Parsing and library in C++20
+ * Copyright 2025 Marcin Markiewicz, marcin.kivrin@gmail.com
+ *
+ * This file is a part of jsontree project
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * Project: jsontree
+ *
+ */
+
+#include <iostream>
+#include <cassert>
+#include <string>
+#include "jsontree.hpp"
+#include "jsontree_lines.hpp"
+
+
+void assert_same_line_tree(const JsonLine& line, const JsonTreeParseOptions& options = {}) {
+    JsonTree tree(line.data);
+    tree.parse(options);
+    assert(line.error_code == tree.get_error_code());
+    assert(line.index == tree.get_index());
+    if (!tree.valid()) {
+        assert(line.root == nullptr);
+        return;
+    }
+    assert(line.root->get_subtree_size() == tree.get_nodes().size());
+    auto node = line.root;
+    for (auto const tree_node : tree.get_nodes()) {
+        assert(node->get_type() == tree_node->get_type());
+        assert(node->get_value_type() == tree_node->get_value_type());
+        assert(node->get_children_count() == tree_node->get_children_count());
+        assert(node->get_subtree_size() == tree_node->get_subtree_size());
+        if (node->is_string() || node->has_raw_number()) {
+            assert(node->get_value_string() == tree_node->get_value_string());
+        } else if (node->is_double()) {
+            assert(node->get_value_double() == tree_node->get_value_double());
+        } else if (node->is_integer()) {
+            assert(node->get_value_uint64() == tree_node->get_value_uint64());
+        }
+        ++node;
+    }
+}
+
+void test_lines_parse() {
+    std::cout << "Test JSON lines parse...";
+    const std::string_view json_data = "{\"id\": 1, \"name\": \"a\\nb\"}\n"
+                                       "\n"
+                                       "  \r\n"
+                                       "[1, 2.5, true]\r\n"
+                                       "{\"id\": 2,}\n"
+                                       "[\"last\"]";
+    JsonLines lines(json_data);
+    assert(!lines.parse());
+    assert(lines.parsed() && !lines.valid());
+    assert(lines.size() == 4);
+    assert(lines.get_errors_count() == 1);
+    assert(lines[0].offset == 0 && lines[0].valid());
+    assert(lines[0].root->find("name")->get_key_value_node()->get_value_string() == "a\nb");
+    assert(lines[1].offset == 31 && lines[1].data == "[1, 2.5, true]\r");
+    assert(lines[1].root->get_children_count() == 3);
+    assert(!lines[2].valid() && lines[2].root == nullptr);
+    assert(lines[2].error_code == JsonTreeParseError::trailing_comma);
+    assert(lines[2].get_error_offset() == 47 + lines[2].index);
+    assert(json_data[lines[2].get_error_offset()] == '}');
+    assert((*lines[3].root->get_children().begin())->get_value_string() == "last");
+    for (const auto& line : lines) {
+        assert_same_line_tree(line);
+    }
+    JsonLines empty(" \n\n");
+    assert(empty.parse() && empty.empty());
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_lines_parallel_parse() {
+    std::cout << "Test JSON lines parallel parse...";
+    std::string json_data;
+    for (int i = 0; i < 5000; ++i) {
+        json_data += "{\"id\": " + std::to_string(i) + ", \"tag\": \"t\\u00e9" + std::to_string(i % 7) + "\"";
+        if (i % 100 == 0) {
+            for (int key = 0; key < 20; ++key) {
+                json_data += ", \"k" + std::to_string(key) + "\": " + std::to_string(key);
+            }
+        }
+        json_data += i % 997 == 0 ? ", ]\n" : "}\n";
+    }
+    JsonThreadPool pool(4);
+    assert(pool.size() == 4);
+    for (const auto& options : {JsonTreeParseOptions{}, JsonTreeParseOptions{.lazy_numbers = true}}) {
+        JsonLines lines(json_data);
+        assert(!lines.parse(pool, options));
+        assert(lines.size() == 5000);
+        assert(lines.get_errors_count() == 6);
+        for (size_t i = 0; i < lines.size(); ++i) {
+            const auto& line = lines[i];
+            assert_same_line_tree(line, options);
+            if (line.valid()) {
+                assert(line.root->find("id")->get_key_value_node()->get_value_int() == static_cast<int>(i));
+                if (i % 100 == 0) {
+                    assert(line.root->find("k19")->get_key_value_node()->get_value_int() == 19);
+                }
+            }
+        }
+    }
+    std::cout << "PASSED" << std::endl;
+}
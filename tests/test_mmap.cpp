@@ -0,0 +1,100 @@
+/*
+* jsontree - JSON Parsing and library in C++20
+ * Copyright 2025 Marcin Markiewicz, marcin.kivrin@gmail.com
+ *
+ * This file is a part of jsontree project
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * Project: jsontree
+ *
+ */
+
+#include <iostream>
+#include <cassert>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include "jsontree.hpp"
+#include "jsontree_mmap.hpp"
+
+
+std::string write_test_file(const std::string& name, const std::string_view content) {
+    const auto path = (std::filesystem::temp_directory_path() / name).string();
+    std::ofstream file(path, std::ios::binary);
+    file << content;
+    return path;
+}
+
+void test_mmap_file_tree() {
+    std::cout << "Test tree of memory mapped file...";
+    const auto path = write_test_file("jsontree_test_mmap.json", R"({"name": "Eryndor", "properties": [1, 2, 3]})");
+    {
+        JsonFileTree tree(path.c_str(), {.huge_pages = true});
+        assert(tree.get_file_error_code() == JsonMappedFileError::no_error);
+        assert(tree.parse());
+        const auto name = tree.get_root()->find("name")->get_key_value_node()->get_value_string();
+        assert(name == "Eryndor");
+        // strings point into the mapping
+        const auto data = tree.get_json_data();
+        assert(name.data() > data.data() && name.data() < data.data() + data.size());
+        assert(tree.get_root()->find("properties")->get_key_value_node()->get_children_count() == 3);
+#ifdef JSONTREE_MMAP
+        assert(tree.get_file().is_mapped());
+#endif
+    }
+    std::filesystem::remove(path);
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_mmap_file_errors() {
+    std::cout << "Test memory mapped file errors...";
+    JsonFileTree missing("/nonexistent/jsontree.json");
+    assert(missing.get_file_error_code() == JsonMappedFileError::open_failed);
+    assert(!missing.parse());
+    assert(missing.get_error_code() == JsonTreeParseError::empty_json_data);
+    const auto path = write_test_file("jsontree_test_empty.json", "");
+    JsonFileTree empty(path.c_str());
+    assert(empty.get_file_error_code() == JsonMappedFileError::no_error);
+    assert(!empty.parse());
+    assert(empty.get_error_code() == JsonTreeParseError::empty_json_data);
+    std::filesystem::remove(path);
+    // mapped file can be moved
+    const auto moved_path = write_test_file("jsontree_test_moved.json", "[1]");
+    JsonMappedFile file(moved_path.c_str());
+    const auto data = file.get_data();
+    const auto moved = std::move(file);
+    assert(moved.get_data() == "[1]" && moved.get_data().data() == data.data());
+    assert(file.get_data().empty());
+    std::filesystem::remove(moved_path);
+#ifdef JSONTREE_MMAP
+    // fifo is read once from the descriptor opened for it
+    const auto fifo_path = (std::filesystem::temp_directory_path() / "jsontree_test_fifo.json").string();
+    std::filesystem::remove(fifo_path);
+    assert(::mkfifo(fifo_path.c_str(), 0600) == 0);
+    std::thread writer([&fifo_path]() {
+        std::ofstream fifo(fifo_path, std::ios::binary);
+        fifo << std::string(100000, ' ') << R"({"fifo": [1, 2]})";
+    });
+    JsonFileTree fifo_tree(fifo_path.c_str());
+    writer.join();
+    assert(fifo_tree.get_file_error_code() == JsonMappedFileError::no_error);
+    assert(!fifo_tree.get_file().is_mapped());
+    assert(fifo_tree.parse());
+    assert(fifo_tree.get_root()->find("fifo")->get_key_value_node()->get_children_count() == 2);
+    std::filesystem::remove(fifo_path);
+#endif
+    std::cout << "PASSED" << std::endl;
+}
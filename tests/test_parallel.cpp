@@ -0,0 +1,123 @@
+/*
+* jsontree - JSON Parsing and library in C++20
+ * Copyright 2025 Marcin Markiewicz, marcin.kivrin@gmail.com
+ *
+ * This file is a part of jsontree project
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * Project: jsontree
+ *
+ */
+
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <vector>
+#include "jsontree.hpp"
+#include "jsontree_parallel.hpp"
+
+
+/**
+ * Compare parallel parse with JsonTree::parse(), see assert_same_tree() in test_chunks.cpp
+ */
+void assert_same_parallel_tree(JsonParallelParser& parser, const std::string_view json_data,
+                               const JsonTreeParseOptions& options = {}) {
+    JsonTree tree(json_data);
+    tree.parse(options);
+    JsonTree parallel_tree(json_data);
+    assert(parser.parse(parallel_tree, options) == tree.valid());
+    assert_same_tree(tree, parallel_tree);
+}
+
+void test_parallel_array_boundaries() {
+    std::cout << "Test parallel array boundaries...";
+    const std::string_view json_data = R"( [1, "a,]\",", [2, 3], {"k": ","}, 4] )";
+    std::vector<size_t> commas;
+    for (const auto level : {JsonSimdLevel::scalar, json_detect_simd_level()}) {
+        assert(json_find_array_boundaries(json_data, 1, commas, level) == json_data.size() - 2);
+        assert((commas == std::vector<size_t>{3, 13, 21, 33}));
+        assert(json_find_array_boundaries(json_data, 12, commas, level) == json_data.size() - 2);
+        assert((commas == std::vector<size_t>{13, 33}));
+    }
+    assert(json_find_array_boundaries("[1, [2, 3]", 1, commas) == 10);
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_parallel_same_as_serial() {
+    std::cout << "Test parallel parse same as serial...";
+    std::string json_data{"[\n"};
+    for (int i = 0; i < 2000; ++i) {
+        if (i > 0) { json_data += ",\n"; }
+        json_data += R"({"id": )" + std::to_string(i) + R"(, "name": "n\"a,m]eé", "values": [1.5, -2, true, null])";
+        if (i % 50 == 0) {
+            for (int key = 0; key < 20; ++key) {
+                json_data += ", \"k" + std::to_string(key) + "\": [" + std::to_string(key) + "]";
+            }
+        }
+        json_data += "}";
+    }
+    json_data += "\n]\n";
+    JsonThreadPool pool(4);
+    JsonParallelParser parser(pool, 1024);
+    for (const auto& options : {JsonTreeParseOptions{}, JsonTreeParseOptions{.lazy_numbers = true},
+                                JsonTreeParseOptions{.decode_escapes = false}}) {
+        assert_same_parallel_tree(parser, json_data, options);
+    }
+    JsonTree tree(json_data);
+    assert(parser.parse(tree));
+    assert(tree.get_root()->get_children_count() == 2000);
+    auto it = tree.get_root()->get_children().begin();
+    for (int i = 0; i < 1000; ++i) { ++it; }
+    const auto item = *it;
+    assert((*item->find("k19")->get_key_value_node()->get_children().begin())->get_value_int() == 19);
+    assert(item->find("name")->get_key_value_node()->get_value_string() == "n\"a,m]eé");
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_parallel_errors() {
+    std::cout << "Test parallel parse errors...";
+    JsonThreadPool pool(3);
+    JsonParallelParser parser(pool, 4);
+    const std::string_view json_data = R"([{"a": [1, 2]}, "x,y", 12.5, [true, null], {"b": "\"]"}, -3])";
+    for (size_t position = 0; position < json_data.size(); ++position) {
+        assert_same_parallel_tree(parser, json_data.substr(0, position));
+        for (const auto c : {' ', ',', ']', '[', '}', '"', '1', 'x', '\\'}) {
+            std::string corrupted{json_data};
+            corrupted[position] = c;
+            assert_same_parallel_tree(parser, corrupted);
+        }
+    }
+    assert_same_parallel_tree(parser, std::string{json_data} + " ]");
+    assert_same_parallel_tree(parser, std::string{json_data} + " x");
+    assert_same_parallel_tree(parser, "{\"a\": [1, 2, 3, 4, 5, 6, 7, 8, 9]}");
+    // ranges which do not fit in the arena of the tree are parsed again by the calling thread
+    for (const size_t capacity : {0, 1, 5, 20}) {
+        alignas(JsonNode) char buffer[20 * sizeof(JsonNode)];
+        JsonNodeArena serial_arena(buffer, capacity * sizeof(JsonNode));
+        JsonTree tree(json_data, serial_arena);
+        tree.parse();
+        alignas(JsonNode) char parallel_buffer[20 * sizeof(JsonNode)];
+        JsonNodeArena parallel_arena(parallel_buffer, capacity * sizeof(JsonNode));
+        JsonTree parallel_tree(json_data, parallel_arena);
+        assert(parser.parse(parallel_tree) == tree.valid());
+        assert(parallel_tree.get_error_code() == tree.get_error_code());
+        assert(parallel_tree.get_index() == tree.get_index());
+        assert(tree.valid() == (capacity == 20));
+        if (tree.valid()) {
+            assert_same_tree(tree, parallel_tree);
+        }
+    }
+    std::cout << "PASSED" << std::endl;
+}
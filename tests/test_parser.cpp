@@ -0,0 +1,122 @@
+/*
+* jsontree - JSON Parsing and library in C++20
+ * Copyright 2025 Marcin Markiewicz, marcin.kivrin@gmail.com
+ *
+ * This file is a part of jsontree project
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * Project: jsontree
+ *
+ */
+
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <utility>
+#include <vector>
+#include "jsontree.hpp"
+#include "jsontree_parser.hpp"
+
+
+void assert_same_document(const JsonTree& tree, const JsonDocument& document) {
+    assert(tree.valid() == document.valid());
+    assert(tree.get_error_code() == document.get_error_code());
+    assert(tree.get_index() == document.get_index());
+    if (!tree.valid()) {
+        return;
+    }
+    assert(tree.get_nodes().size() == document.get_nodes().size());
+    auto node = document.get_root();
+    for (auto const tree_node : tree.get_nodes()) {
+        assert(node->get_type() == tree_node->get_type());
+        assert(node->get_value_type() == tree_node->get_value_type());
+        assert(node->get_children_count() == tree_node->get_children_count());
+        assert(node->get_subtree_size() == tree_node->get_subtree_size());
+        if (node->is_string() || node->has_raw_number()) {
+            assert(node->get_value_string() == tree_node->get_value_string());
+        } else if (node->is_double()) {
+            assert(node->get_value_double() == tree_node->get_value_double());
+        } else if (node->is_integer()) {
+            assert(node->get_value_uint64() == tree_node->get_value_uint64());
+        }
+        ++node;
+    }
+}
+
+void test_parser_reuse() {
+    std::cout << "Test parser reused for many documents...";
+    const std::vector<std::string_view> documents{
+        R"({"k1": [12, -3.5e+2, true, null, "a\"b\\"], "k2": {"k\n3": 18446744073709551615}})",
+        "[1, 2,]",
+        R"(["éé", {"a": {"b": [[], {}]}}])",
+        "",
+        R"({"k": "v"} x)",
+        R"([{"a": 1}, {"b": 2}])",
+    };
+    JsonParser parser;
+    JsonDocument document;
+    for (int round = 0; round < 3; ++round) {
+        for (const auto json_data : documents) {
+            for (const auto& options : {JsonTreeParseOptions{}, JsonTreeParseOptions{.lazy_numbers = true},
+                                        JsonTreeParseOptions{.structural_index = true}}) {
+                JsonTree tree(json_data);
+                tree.parse(options);
+                assert(parser.parse(json_data, document, options) == tree.valid());
+                assert(document.parsed());
+                assert_same_document(tree, document);
+                assert_same_document(tree, parser.parse(json_data, options));
+            }
+        }
+    }
+    assert(!parser.parse("", document));
+    assert(document.empty() && document.get_root() == nullptr);
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_parser_document_move() {
+    std::cout << "Test parser document move...";
+    std::string json_data{"{"};
+    for (int key = 0; key < 40; ++key) {
+        json_data += (key > 0 ? ", \"k" : "\"k") + std::to_string(key) + "\": \"v\\t" + std::to_string(key) + "\"";
+    }
+    json_data += "}";
+    JsonParser parser;
+    std::vector<JsonDocument> documents;
+    for (int i = 0; i < 10; ++i) {
+        documents.push_back(parser.parse(json_data));
+    }
+    const auto root = documents[0].get_root();
+    assert(root->find("k7")->get_key_value_node()->get_value_string() == "v\t7");
+    auto moved = std::move(documents[0]);
+    assert(moved.get_root() == root);
+    assert(documents[0].empty());
+    assert(moved.get_root()->find("k39")->get_key_value_node()->get_value_string() == "v\t39");
+    // objects of moved document use its pool, also when they were not searched before the move
+    JsonDocument assigned;
+    assigned = std::move(documents[1]);
+    assert(documents[1].get_root() == nullptr);
+    documents[1] = parser.parse("[1]");
+    assert(assigned.get_root()->find("k21")->get_key_value_node()->get_value_string() == "v\t21");
+    const JsonDocument constructed(std::move(documents[2]));
+    assert(constructed.get_root()->find("k3")->get_key_value_node()->get_value_string() == "v\t3");
+    // document in caller buffer
+    alignas(JsonNode) char buffer[JsonNodeArena::buffer_size_for(16)];
+    JsonDocument small(buffer, sizeof(buffer));
+    assert(parser.parse("[1, [2, 3], {\"a\": 4}]", small));
+    assert(small.get_nodes().size() == 8);
+    assert(!parser.parse(json_data, small));
+    assert(small.get_error_code() == JsonTreeParseError::out_of_memory);
+    std::cout << "PASSED" << std::endl;
+}
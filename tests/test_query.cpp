@@ -0,0 +1,98 @@
+/*
+* jsontree - JSON Parsing and library in C++20
+ * Copyright 2025 Marcin Markiewicz, marcin.kivrin@gmail.com
+ *
+ * This file is a part of jsontree project
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * Project: jsontree
+ *
+ */
+
+#include <iostream>
+#include <cassert>
+#include "jsontree.hpp"
+#include "jsontree_query.hpp"
+
+
+const std::string_view query_json_data = R"({
+    "servers": [
+        {"name": "alpha", "ports": [80, 443]},
+        {"name": "beta", "ports": []},
+        {"name": "gamma", "ports": [8080]},
+        {"name": "delta", "ports": [22, 2222, 22222], "a/b": 1, "m~n": 2, "x.y": 3, "7": "seven"}
+    ],
+    "": "empty key"
+})";
+
+void test_query_pointer() {
+    std::cout << "Test query with JSON pointer...";
+    JsonTree tree(query_json_data);
+    assert(tree.parse());
+    assert(JsonQuery::from_pointer("").find(tree) == tree.get_root());
+    assert(JsonQuery::from_pointer("/servers/3/ports/1").find(tree)->get_value_int() == 2222);
+    assert(JsonQuery::from_pointer("/servers/0/name").find(tree)->get_value_string() == "alpha");
+    assert(JsonQuery::from_pointer("/servers/3/a~1b").find(tree)->get_value_int() == 1);
+    assert(JsonQuery::from_pointer("/servers/3/m~0n").find(tree)->get_value_int() == 2);
+    assert(JsonQuery::from_pointer("/servers/3/7").find(tree)->get_value_string() == "seven");
+    assert(JsonQuery::from_pointer("/").find(tree)->get_value_string() == "empty key");
+    assert(JsonQuery::from_pointer("/servers/4").find(tree) == nullptr);
+    assert(JsonQuery::from_pointer("/servers/-").find(tree) == nullptr);
+    assert(JsonQuery::from_pointer("/servers/01").find(tree) == nullptr);
+    assert(JsonQuery::from_pointer("/servers/0/name/x").find(tree) == nullptr);
+    const auto missing_slash = JsonQuery::from_pointer("servers");
+    assert(!missing_slash.valid());
+    assert(missing_slash.get_error_code() == JsonQueryError::pointer_must_start_with_slash);
+    const auto invalid_escape = JsonQuery::from_pointer("/servers/a~2");
+    assert(invalid_escape.get_error_code() == JsonQueryError::invalid_pointer_escape);
+    assert(invalid_escape.get_error_index() == 10);
+    assert(invalid_escape.find(tree) == nullptr);
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_query_path() {
+    std::cout << "Test query with path...";
+    JsonTree tree(query_json_data);
+    assert(tree.parse());
+    assert(JsonQuery::from_path("servers[3].ports[2]").find(tree)->get_value_int() == 22222);
+    assert(JsonQuery::from_path(R"(servers[3]["x.y"])").find(tree)->get_value_int() == 3);
+    assert(JsonQuery::from_path("servers[3].7").find(tree)->get_value_string() == "seven");
+    assert(JsonQuery::from_path("servers.0").find(tree) == nullptr);
+    const auto ports = JsonQuery::from_path("servers[*].ports[*]").find_all(tree);
+    const std::vector<int> expected{80, 443, 8080, 22, 2222, 22222};
+    assert(ports.size() == expected.size());
+    for (size_t i = 0; i < ports.size(); ++i) {
+        assert(ports[i]->get_value_int() == expected[i]);
+    }
+    assert(JsonQuery::from_path("servers[*].name").find(tree)->get_value_string() == "alpha");
+    assert(JsonQuery::from_path("servers[*].ports[1]").find_all(tree).size() == 2);
+    assert(JsonQuery::from_path("servers[3].*").find_all(tree).size() == 6);
+    // the same compiled query runs against many trees
+    const auto first_port = JsonQuery::from_path("servers[0].ports[0]");
+    for (const auto* json_data : {R"({"servers": [{"ports": [1]}]})", R"({"servers": [{"ports": [2, 3]}]})"}) {
+        JsonTree other_tree(json_data);
+        assert(other_tree.parse());
+        assert(first_port.find(other_tree)->is_int());
+    }
+    for (const auto* path : {"servers..name", "servers.", "servers[1", "servers[x]", "servers[01]", "servers[0]name",
+                             R"(servers["name)", "[-1]"}) {
+        const auto query = JsonQuery::from_path(path);
+        assert(!query.valid());
+        assert(query.find(tree) == nullptr);
+    }
+    assert(JsonQuery::from_path("servers[0]name").get_error_code() == JsonQueryError::unexpected_character);
+    assert(JsonQuery::from_path("servers[0]name").get_error_index() == 10);
+    std::cout << "PASSED" << std::endl;
+}
@@ -0,0 +1,114 @@
+/*
+* jsontree - JSON Parsing and library in C++20
+ * Copyright 2025 Marcin Markiewicz, marcin.kivrin@gmail.com
+ *
+ * This file is a part of jsontree project
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * Project: jsontree
+ *
+ */
+
+#include <iostream>
+#include <cassert>
+#include <string>
+#include "jsontree.hpp"
+
+
+/**
+ * Handler which writes events as text
+ */
+struct JsonEventsRecorder {
+    std::string events{};
+
+    void on_object_start() { events += "{"; }
+    void on_object_end() { events += "}"; }
+    void on_array_start() { events += "["; }
+    void on_array_end() { events += "]"; }
+    void on_key(const std::string_view key) { events += "k:" + std::string(key) + " "; }
+    void on_string(const std::string_view value) { events += "s:" + std::string(value) + " "; }
+    void on_int(const int value) { events += "i:" + std::to_string(value) + " "; }
+    void on_int64(const int64_t value) { events += "l:" + std::to_string(value) + " "; }
+    void on_uint64(const uint64_t value) { events += "u:" + std::to_string(value) + " "; }
+    void on_double(const double value) { events += "d:" + std::to_string(value) + " "; }
+    void on_boolean(const bool value) { events += value ? "true " : "false "; }
+    void on_null() { events += "null "; }
+};
+
+/**
+ * Handler which counts values and stops after given number of them
+ */
+struct JsonEventsCounter {
+    size_t values{0};
+    size_t limit{SIZE_MAX};
+
+    bool count() { return ++values < limit; }
+    bool on_object_start() { return true; }
+    bool on_object_end() { return true; }
+    bool on_array_start() { return true; }
+    bool on_array_end() { return true; }
+    bool on_key(std::string_view) { return true; }
+    bool on_string(std::string_view) { return count(); }
+    bool on_int(int) { return count(); }
+    bool on_int64(int64_t) { return count(); }
+    bool on_uint64(uint64_t) { return count(); }
+    bool on_double(double) { return count(); }
+    bool on_boolean(bool) { return count(); }
+    bool on_null() { return count(); }
+};
+
+void test_sax_events() {
+    std::cout << "Test sax parser events...";
+    JsonEventsRecorder recorder{};
+    JsonSaxParser parser(R"({"a": [1, 3000000000, 18446744073709551615, 0.5, "x\ny"], "b\"": {"c": null}, "d": true})",
+                         recorder);
+    assert(parser.parse());
+    assert(parser.get_depth() == 0);
+    assert(recorder.events ==
+        "{k:a [i:1 l:3000000000 u:18446744073709551615 d:0.500000 s:x\ny ]k:b\" {k:c null }k:d true }");
+    // raw numbers are passed only to handlers which accept them
+    JsonEventsRecorder lazy_recorder{};
+    JsonSaxParser lazy_parser("[12, 1.5]", lazy_recorder);
+    assert(lazy_parser.parse({.lazy_numbers = true}));
+    assert(lazy_recorder.events == "[i:12 d:1.500000 ]");
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_sax_same_errors_as_tree() {
+    std::cout << "Test sax parser reports same errors as tree...";
+    for (const auto* json_data : {"", "123", R"({"k1": "example"}"k2":"v2")", "[1 2 3]", R"({"k1" "v1"})", "}",
+                                  R"(["k1"})", "[,1]", "[1,2,]", "[89.78.77]", "[1, @]", R"(["a\q"])", "[tru e]",
+                                  R"({"a": [1, {"b": 2})", "[1e999]"}) {
+        JsonTree tree(json_data);
+        JsonEventsCounter counter{};
+        JsonSaxParser parser(json_data, counter);
+        assert(!tree.parse());
+        assert(!parser.parse());
+        assert(tree.get_error_code() == parser.get_error_code());
+        assert(tree.get_index() == parser.get_index());
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_sax_stopped_by_handler() {
+    std::cout << "Test sax parser stopped by handler...";
+    JsonEventsCounter counter{.limit = 3};
+    JsonSaxParser parser("[1, [2, 3, 4], 5]", counter);
+    assert(!parser.parse());
+    assert(parser.get_error_code() == JsonTreeParseError::stopped_by_handler);
+    assert(counter.values == 3);
+    assert(parser.get_depth() == 2);
+    std::cout << "PASSED" << std::endl;
+}
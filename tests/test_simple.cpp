@@ -164,3 +164,80 @@ void test_parse_array_with_simple_values() {
     }
     std::cout << "PASSED" << std::endl;
 }
+
+void test_parse_array_with_wide_integers() {
+    std::cout << "Test with array with wide integers...";
+    JsonTree tree(R"([2147483647, -2147483648, 2147483648, -9223372036854775808, 18446744073709551615, 1.5e300])");
+    assert(tree.parse());
+    assert(tree.valid());
+    const auto items = tree.get_root()->get_children();
+    auto it = items.begin();
+    assert((*it)->is_int() && (*it)->get_value_int() == INT_MAX);
+    ++it;
+    assert((*it)->is_int() && (*it)->get_value_int() == INT_MIN);
+    assert((*it)->get_value_int64() == INT_MIN);
+    ++it;
+    assert((*it)->is_int64() && (*it)->get_value_int64() == 2147483648LL);
+    ++it;
+    assert((*it)->is_int64() && (*it)->get_value_int64() == INT64_MIN);
+    ++it;
+    assert((*it)->is_uint64() && (*it)->get_value_uint64() == UINT64_MAX);
+    assert((*it)->is_integer());
+    ++it;
+    assert((*it)->is_double() && (*it)->get_value_double() == 1.5e300);
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_parse_lazy_numbers() {
+    std::cout << "Test with lazy decoded numbers...";
+    const std::string json_data = R"([12, -345, 1.25, -2.5e-3, 1.e5, -.5, 007, 3000000000, 1e200, 1.5e+07, -0])";
+    JsonTree tree(json_data);
+    JsonTree lazy_tree(json_data);
+    assert(tree.parse());
+    assert(lazy_tree.parse({.lazy_numbers = true}));
+    const auto items = lazy_tree.get_root()->get_children();
+    assert(items.front()->has_raw_number());
+    assert(items.front()->get_raw_number() == "12");
+    auto it = items.begin();
+    for (auto const item : tree.get_root()->get_children()) {
+        assert(item->get_value_type() == (*it)->get_value_type());
+        if (item->is_double()) {
+            assert(item->get_value_double() == (*it)->get_value_double());
+        } else {
+            assert(item->get_value_int64() == (*it)->get_value_int64());
+        }
+        assert(!(*it)->has_raw_number());
+        ++it;
+    }
+    // wide integers and long exponents are decoded eagerly
+    assert(!(*std::next(items.begin(), 7))->has_raw_number());
+    assert(!(*std::next(items.begin(), 8))->has_raw_number());
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_parse_escaped_strings() {
+    std::cout << "Test with escaped strings...";
+    const std::string json_data = R"({"plain": "text", "k\"1": "a\"b\\c\/d\n\t\b\f\r", "u": "\u00e9\u20AC\ud83d\ude00"})";
+    JsonTree tree(json_data);
+    assert(tree.parse());
+    assert(tree.valid());
+    const auto plain = tree.get_root()->get_children().front();
+    assert(!plain->has_escapes());
+    assert(plain->get_key_name() == "plain");
+    // strings without escape sequences point into json data
+    assert(plain->get_key_name().data() == json_data.data() + 2);
+    const auto escaped = plain->get_next_sibling();
+    assert(escaped->has_escapes());
+    assert(escaped->get_key_name() == "k\"1");
+    assert(escaped->get_key_value_node()->get_value_string() == "a\"b\\c/d\n\t\b\f\r");
+    const auto unicode = escaped->get_next_sibling()->get_key_value_node();
+    assert(unicode->has_escapes());
+    assert(unicode->get_value_string() == "\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80");
+    // raw text stays when decoding is disabled
+    JsonTree raw_tree(json_data);
+    assert(raw_tree.parse({.decode_escapes = false}));
+    const auto raw = raw_tree.get_root()->get_children().front()->get_next_sibling();
+    assert(raw->has_escapes());
+    assert(raw->get_key_name() == R"(k\"1)");
+    std::cout << "PASSED" << std::endl;
+}
@@ -0,0 +1,243 @@
+/*
+* jsontree - JSON Parsing and library in C++20
+ * Copyright 2025 Marcin Markiewicz, marcin.kivrin@gmail.com
+ *
+ * This file is a part of jsontree project
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * Project: jsontree
+ *
+ */
+#include <iostream>
+#include <fstream>
+#include <bit>
+#include <cassert>
+#include <charconv>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "jsontree.hpp"
+#include "jsontree_static.hpp"
+
+
+template <JsonLiteral Json>
+void assert_same_static_tree() {
+    constexpr auto& static_tree = json_static_tree<Json>;
+    JsonTree tree(static_tree.get_json_data());
+    assert(tree.parse());
+    assert(tree.get_nodes().size() == static_tree.size());
+    auto node = static_tree.get_root();
+    for (auto const tree_node : tree.get_nodes()) {
+        assert(node->get_type() == tree_node->get_type());
+        assert(node->get_value_type() == tree_node->get_value_type());
+        assert(node->get_children_count() == tree_node->get_children_count());
+        assert(node->get_subtree_size() == tree_node->get_subtree_size());
+        assert(node->has_escapes() == tree_node->has_escapes());
+        if (node->is_string() || node->is_key()) {
+            assert(node->get_value_string() == tree_node->get_value_string());
+        } else if (node->is_double()) {
+            assert(node->get_value_double() == tree_node->get_value_double());
+        } else if (node->is_integer()) {
+            assert(node->get_value_uint64() == tree_node->get_value_uint64());
+        }
+        ++node;
+    }
+}
+
+void test_static_same_as_tree() {
+    std::cout << "Test static tree same as parsed tree...";
+    assert_same_static_tree<R"({"k1": [12, -3.5e+2, true, null, "a\"b\\"], "k2": {"k\n3": 18446744073709551615}})">();
+    assert_same_static_tree<R"(["é😀", {"a": {"b": [[], {}]}}, -0.0, 1E5, 0.001, -2147483649])">();
+    assert_same_static_tree<R"([{"a": 1}, {"b": 2}, [1,,2]])">();
+    assert_same_static_tree<"{}">();
+    // strings table starts with the json data, strings without escapes are its parts, decoded ones follow it
+    constexpr auto& config = json_static_tree<R"({"baud": 115200, "name": "uart\t0", "pins": [4, 5]})">;
+    const auto json_data = config.get_json_data();
+    const auto baud = config.get_root()->find("baud");
+    assert(baud->get_key_value_node()->get_value_int() == 115200);
+    assert(baud->get_key_name().data() > json_data.data());
+    assert(baud->get_key_name().data() < json_data.data() + json_data.size());
+    const auto name = config.get_root()->find("name")->get_key_value_node()->get_value_string();
+    assert(name == "uart\t0");
+    assert(name.data() < json_data.data() || name.data() >= json_data.data() + json_data.size());
+    assert(config.get_root()->find("pins")->get_key_value_node()->get_children().back()->get_value_int() == 5);
+    assert(config.get_root()->find("none") == nullptr);
+    std::cout << "PASSED" << std::endl;
+}
+
+/**
+ * True if address is in a mapping of the process without write permission
+ */
+bool is_read_only_memory(const void* address) {
+    const auto value = reinterpret_cast<uintptr_t>(address);
+    std::ifstream maps("/proc/self/maps");
+    std::string line;
+    while (std::getline(maps, line)) {
+        uintptr_t start = 0;
+        uintptr_t end = 0;
+        const auto dash = line.find('-');
+        const auto space = line.find(' ');
+        std::from_chars(line.data(), line.data() + dash, start, 16);
+        std::from_chars(line.data() + dash + 1, line.data() + space, end, 16);
+        if (value >= start && value < end) {
+            return line[space + 2] != 'w';
+        }
+    }
+    return false;
+}
+
+void test_static_read_only() {
+    std::cout << "Test static tree read only...";
+    constexpr auto& config = json_static_tree<R"({"baud": 115200, "name": "uart\t0", "pins": [4, 5]})">;
+    // accessors of static nodes work in constant expressions
+    static_assert(config.get_root()->find("baud")->get_key_value_node()->get_value_int() == 115200);
+    static_assert(config.get_root()->find("name")->get_key_value_node()->get_value_string() == "uart\t0");
+    static_assert(config.get_root()->find("pins")->get_key_value_node()->get_children().back()->get_value_int() == 5);
+    static_assert(config.get_root()->find("none") == nullptr);
+    static_assert(config.get_root()->get_next_sibling() == config.get_root() + config.size());
+#ifdef __linux__
+    // nodes have no mutable members and no pointers, so the table is placed in read-only data
+    assert(is_read_only_memory(config.get_nodes().data()));
+    assert(is_read_only_memory(config.get_strings().data()));
+    static int writable_data = 0;
+    assert(!is_read_only_memory(&writable_data));
+#endif
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_static_errors() {
+    std::cout << "Test static parse errors...";
+    static_assert(json_static_scan(R"({"k": [1, 2,]})").error_code == JsonTreeParseError::trailing_comma);
+    static_assert(json_static_scan(R"({"k" 1})").error_code == JsonTreeParseError::missing_colon);
+    static_assert(json_static_scan(R"(["\x"])").error_code == JsonTreeParseError::invalid_escape_sequence);
+    static_assert(json_static_scan("[1] 2").error_code == JsonTreeParseError::no_parent);
+    static_assert(json_static_scan("[1e999]").error_code == JsonTreeParseError::number_out_of_range);
+    static_assert(json_static_scan("[1e-999]").error_code == JsonTreeParseError::number_out_of_range);
+    static_assert(json_static_scan("[1, 2]").nodes_count == 3);
+    static_assert(json_static_scan(R"(["a\tb", "é"])").strings_size == 14 + 3);
+    static_assert(json_static_scan("[0.12345678901234567891, 9007199254740993.0, 1.5e300, 4.9e-324]").valid());
+    const std::vector<std::string_view> documents{
+        "", "  ", "1", R"("s")", "[1, 2", R"({"a": 1)", "[1 2]", R"({"a": 1 "b": 2})", R"({1: 2})", "{]", "[}",
+        "]", "}", R"(["a":1])", "[,1]", ", 1", "[tru]", "[1.2.3]", "[1-2]", "[+1]", "[@]", R"(["a)",
+        "[99999999999999999999]", "[-9223372036854775809]", "[1e]", "[-]", "[1e999.]", "[1.7976931348623159e308]",
+        "[2.4703282292062327e-324]", "[-1e-400]", "[1.5e+]",
+    };
+    for (const auto json_data : documents) {
+        JsonTree tree(json_data);
+        assert(!tree.parse());
+        const auto scan = json_static_scan(json_data);
+        assert(scan.error_code == tree.get_error_code());
+        assert(scan.index == tree.get_index());
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+constexpr double json_static_double(const std::string_view literal) {
+    double number{};
+    json_decimal_from_chars(literal.data(), literal.data() + literal.size(), number);
+    return number;
+}
+
+/**
+ * Multiply decimal digits by small factor, used to print exact halfway points between doubles
+ */
+void multiply_decimal(std::string& digits, const int factor) {
+    int carry = 0;
+    for (auto it = digits.rbegin(); it != digits.rend(); ++it) {
+        const auto product = (*it - '0') * factor + carry;
+        *it = static_cast<char>('0' + product % 10);
+        carry = product / 10;
+    }
+    for (; carry > 0; carry /= 10) {
+        digits.insert(digits.begin(), static_cast<char>('0' + carry % 10));
+    }
+}
+
+void assert_same_double(const std::string& literal) {
+    const auto first = literal.data();
+    const auto last = literal.data() + literal.size();
+    double expected{};
+    const auto expected_result = std::from_chars(first, last, expected);
+    double number{};
+    const auto result = json_decimal_from_chars(first, last, number);
+    assert(result.ec == expected_result.ec);
+    assert(result.ptr == expected_result.ptr);
+    if (result.ec == std::errc{}) {
+        assert(std::bit_cast<uint64_t>(number) == std::bit_cast<uint64_t>(expected));
+    }
+}
+
+void test_static_numbers() {
+    std::cout << "Test static numbers...";
+    // doubles are correctly rounded at compile time, the same as by the compiler
+    static_assert(json_static_double("0.12345678901234567891") == 0.12345678901234567891);
+    static_assert(json_static_double("9007199254740993") == 9007199254740993.0);
+    static_assert(json_static_double("9007199254740995") == 9007199254740995.0);
+    static_assert(json_static_double("1.5e300") == 1.5e300);
+    static_assert(json_static_double("-2.2250738585072011e-308") == -2.2250738585072011e-308);
+    static_assert(json_static_double("4.9e-324") == 4.9e-324);
+    static_assert(json_static_double("1.7976931348623157e308") == 1.7976931348623157e308);
+    static_assert(json_static_double("123456789012345678901234567890e-20") == 123456789012345678901234567890e-20);
+    static_assert(std::bit_cast<uint64_t>(json_static_double("-0.0")) == std::bit_cast<uint64_t>(-0.0));
+    constexpr auto& tree = json_static_tree<"[0.1, 1e23, 2.5e-320, -9223372036854775808]">;
+    assert(tree.get_root()->get_children().front()->get_value_double() == 0.1);
+    assert(tree.get_nodes()[2].get_value_double() == 1e23);
+    assert(tree.get_nodes()[3].get_value_double() == 2.5e-320);
+    assert(tree.get_nodes()[4].get_value_int64() == INT64_MIN);
+    // same results as std::from_chars for random literals and exact halfway points between doubles
+    std::mt19937_64 random(2025);
+    for (int i = 0; i < 20000; ++i) {
+        std::string literal = random() % 4 == 0 ? "-" : "";
+        const auto digits = random() % 8 == 0 ? 700 + random() % 200 : 1 + random() % 40;
+        for (size_t digit = 0; digit < digits; ++digit) {
+            literal += static_cast<char>('0' + random() % 10);
+        }
+        if (random() % 2 == 0) {
+            literal.insert(random() % literal.size() + 1, ".");
+        }
+        if (random() % 4 != 0) {
+            literal += "e" + std::to_string(static_cast<int>(random() % 1400) - 1000);
+        }
+        assert_same_double(literal);
+    }
+    for (int i = 0; i < 300; ++i) {
+        const auto bits = random() % 0x7FEFFFFFFFFFFFFFull;
+        const auto exponent_bits = static_cast<int>(bits >> 52);
+        auto mantissa = bits & ((uint64_t{1} << 52) - 1);
+        mantissa = exponent_bits == 0 ? mantissa : mantissa | uint64_t{1} << 52;
+        const auto exponent = (exponent_bits == 0 ? 1 : exponent_bits) - 1075; // value is mantissa * 2^exponent
+        std::string halfway = std::to_string(2 * mantissa + 1);
+        for (auto power = exponent - 1; power > 0; --power) {
+            multiply_decimal(halfway, 2);
+        }
+        for (auto power = exponent - 1; power < 0; ++power) {
+            multiply_decimal(halfway, 5);
+        }
+        const auto decimal_exponent = std::min(exponent - 1, 0);
+        assert_same_double(halfway + "e" + std::to_string(decimal_exponent));
+        // digits beyond the first 800 decide the rounding
+        const auto padding = 850 - static_cast<int>(halfway.size());
+        assert_same_double(halfway + std::string(padding, '0') + "1e" + std::to_string(decimal_exponent - padding - 1));
+        std::string below = halfway;
+        auto digit = below.rbegin();
+        for (; *digit == '0'; ++digit) {
+            *digit = '9';
+        }
+        --*digit;
+        assert_same_double(below + std::string(padding, '9') + "e" + std::to_string(decimal_exponent - padding));
+    }
+    std::cout << "PASSED" << std::endl;
+}
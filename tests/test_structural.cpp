@@ -0,0 +1,166 @@
+/*
+* jsontree - JSON Parsing and library in C++20
+ * Copyright 2025 Marcin Markiewicz, marcin.kivrin@gmail.com
+ *
+ * This file is a part of jsontree project
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * Project: jsontree
+ *
+ */
+
+#include <algorithm>
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <vector>
+#include "jsontree.hpp"
+
+
+std::vector<uint32_t> build_structural_index(const std::string_view json_data, const JsonSimdLevel level) {
+    std::vector<uint32_t> positions{};
+    json_build_structural_index(json_data, positions, level);
+    return positions;
+}
+
+std::vector<JsonSimdLevel> available_simd_levels() {
+    std::vector levels{JsonSimdLevel::scalar};
+    if (json_detect_simd_level() >= JsonSimdLevel::sse42) { levels.push_back(JsonSimdLevel::sse42); }
+    if (json_detect_simd_level() >= JsonSimdLevel::avx2) { levels.push_back(JsonSimdLevel::avx2); }
+    return levels;
+}
+
+void assert_same_parse(const std::string_view json_data) {
+    JsonTree tree(json_data);
+    JsonTree indexed_tree(json_data);
+    assert(tree.parse() == indexed_tree.parse({.structural_index = true}));
+    assert(tree.get_error_code() == indexed_tree.get_error_code());
+    assert(tree.get_index() == indexed_tree.get_index());
+    assert(tree.get_nodes().size() == indexed_tree.get_nodes().size());
+    auto it = indexed_tree.get_nodes().begin();
+    for (auto const node : tree.get_nodes()) {
+        assert(node->get_type() == (*it)->get_type());
+        assert(node->get_value_type() == (*it)->get_value_type());
+        assert(node->get_children_count() == (*it)->get_children_count());
+        assert(node->get_subtree_size() == (*it)->get_subtree_size());
+        if (node->is_string()) {
+            assert(node->get_value_string() == (*it)->get_value_string());
+        }
+        ++it;
+    }
+}
+
+void test_structural_index_positions() {
+    std::cout << "Test structural index positions...";
+    const std::string_view json_data = R"({"k1": [12, true], "k\"2": "a,b"})";
+    const std::vector<uint32_t> expected{0, 1, 4, 5, 7, 8, 10, 12, 16, 17, 19, 24, 25, 27, 31, 32};
+    for (const auto level : available_simd_levels()) {
+        assert(build_structural_index(json_data, level) == expected);
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_structural_index_block_boundaries() {
+    std::cout << "Test structural index across block boundaries...";
+    for (size_t padding = 50; padding < 80; ++padding) {
+        for (size_t backslashes = 1; backslashes < 6; ++backslashes) {
+            std::string json_data = "[" + std::string(padding, ' ') + "\"";
+            json_data += std::string(backslashes, '\\') + (backslashes % 2 == 1 ? "\"" : "") + "x\", 1234]";
+            const auto expected = build_structural_index(json_data, JsonSimdLevel::scalar);
+            assert(expected.size() == 6);
+            assert(json_data[expected[2]] == '"');
+            for (const auto level : available_simd_levels()) {
+                assert(build_structural_index(json_data, level) == expected);
+            }
+            assert_same_parse(json_data);
+        }
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_structural_index_parse_same_as_bytes() {
+    std::cout << "Test parse with structural index same as without...";
+    const std::vector<std::string_view> documents{
+        "", "  \n\t", "123", "\"example\"", "{}", "[]", R"({"k1": "example"})",
+        R"({"k1": "example", "k2": {"k2.2": "example2"}})", R"([[1, [2, 3]], {"k1": {"k1.1": [4]}, "k2": 5}, 6])",
+        R"({"k1: "example"})", R"({"k1": "example"}"k2":"v2")", R"({"k1": "example" "k2": "v2"})", "[1 2 3]",
+        R"({"k1" "v1","k2": "v2"})", "}", R"(["k1"})", "]", R"({"k1"])", "[123, 456:, 789]", ",", "[,123,234,456]",
+        R"({"k1":"value","k2":nullable})", R"({"k1":"v1","k2":"v2",})", "[1,2,3,]", R"(["v1","v2")", "[89.78.77]",
+        "[89-77.45]", "[34+e15]", "[123, 345, 34-45]", "[1, @]", "[1,\v2]", "[123abc]", "[\"abc", "[\"abc\\", "[tru e]",
+        R"([ "a\\", "b\\\"c", -1.5e+3, false, null ])", R"({"k\n1": ["\u00e9\ud83d\ude00", "\/"]})", R"(["a\q"])",
+        R"(["\ud83d"])",
+    };
+    for (const auto json_data : documents) {
+        assert_same_parse(json_data);
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+size_t find_string_end_bytes(const std::string_view json_data, size_t index) {
+    while (index < json_data.size() && json_data[index] != '"') {
+        if (json_data[index] == '\\' && index + 1 < json_data.size()) {
+            index++;
+        }
+        index++;
+    }
+    return index;
+}
+
+void test_find_string_end() {
+    std::cout << "Test find string end...";
+    const std::vector<std::string> bodies{
+        "", "abc", "\\\"", "\\\\", "\\\\\\\"", std::string(40, 'x') + "\\\"" + std::string(20, 'y'),
+        std::string(15, '\\'), std::string(16, '\\'), std::string(33, 'z') + "\\",
+    };
+    for (const auto& body : bodies) {
+        for (size_t prefix = 0; prefix < 40; ++prefix) {
+            for (const auto* suffix : {"\"", "\", 1]", ""}) {
+                const auto json_data = std::string(prefix, 'p') + body + suffix;
+                for (size_t start = 0; start <= prefix; ++start) {
+                    assert(json_find_string_end(json_data, start) == find_string_end_bytes(json_data, start));
+                }
+            }
+        }
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_find_escaped_char() {
+    std::cout << "Test find escaped char...";
+    // bytes above 0x7F must not be taken for control characters
+    for (const auto c : {'"', '\\', '\x00', '\n', '\x1F'}) {
+        for (size_t position = 0; position < 40; ++position) {
+            const auto json_data = std::string(position, '\xC3') + c + std::string(20, ' ');
+            for (size_t start = 0; start <= position; ++start) {
+                assert(json_find_escaped_char(json_data, start) == std::max(start, position));
+            }
+        }
+    }
+    assert(json_find_escaped_char(std::string(50, '\x20') + "\x7F\x80\xFF", 0) == 53);
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_skip_whitespaces() {
+    std::cout << "Test skip whitespaces...";
+    for (size_t indent = 0; indent < 40; ++indent) {
+        for (const auto* tail : {"", "x", "\v", "\f ", "\"a\""}) {
+            const auto json_data = "\r\n" + std::string(indent, ' ') + "\t" + tail;
+            const auto expected = json_data.size() - std::string_view(tail).size();
+            assert(json_skip_whitespaces(json_data, 0) == expected);
+            assert(json_skip_whitespaces(json_data, expected) == expected);
+        }
+    }
+    std::cout << "PASSED" << std::endl;
+}
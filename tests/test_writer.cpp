@@ -0,0 +1,165 @@
+/*
+* jsontree - JSON Parsing and library in C++20
+ * Copyright 2025 Marcin Markiewicz, marcin.kivrin@gmail.com
+ *
+ * This file is a part of jsontree project
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * Project: jsontree
+ *
+ */
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "jsontree.hpp"
+#include "jsontree_writer.hpp"
+
+
+void assert_same_nodes(const JsonTree& tree, const JsonTree& written_tree) {
+    assert(tree.valid() && written_tree.valid());
+    assert(tree.get_nodes().size() == written_tree.get_nodes().size());
+    auto it = written_tree.get_nodes().begin();
+    for (auto const node : tree.get_nodes()) {
+        assert(node->get_type() == (*it)->get_type());
+        assert(node->get_value_type() == (*it)->get_value_type());
+        assert(node->get_children_count() == (*it)->get_children_count());
+        assert(node->get_subtree_size() == (*it)->get_subtree_size());
+        if (node->is_string() || node->is_key()) {
+            assert(node->get_value_string() == (*it)->get_value_string());
+        } else if (node->is_double()) {
+            assert(node->get_value_double() == (*it)->get_value_double());
+        } else if (node->is_integer()) {
+            assert(node->get_value_uint64() == (*it)->get_value_uint64());
+        }
+        ++it;
+    }
+}
+
+void test_writer_minified_and_pretty() {
+    std::cout << "Test writer minified and pretty...";
+    JsonTree tree(R"( {"a": [1, -2.5, 3.0, 1e300, true, null], "b": {}, "c": [], "d": {"e": "f"}} )");
+    assert(tree.parse());
+    assert(json_write(tree) == R"({"a":[1,-2.5,3.0,1e+300,true,null],"b":{},"c":[],"d":{"e":"f"}})");
+    assert(json_write(tree, {.pretty = true, .indent = 1}) == "{\n"
+                                                              " \"a\": [\n"
+                                                              "  1,\n"
+                                                              "  -2.5,\n"
+                                                              "  3.0,\n"
+                                                              "  1e+300,\n"
+                                                              "  true,\n"
+                                                              "  null\n"
+                                                              " ],\n"
+                                                              " \"b\": {},\n"
+                                                              " \"c\": [],\n"
+                                                              " \"d\": {\n"
+                                                              "  \"e\": \"f\"\n"
+                                                              " }\n"
+                                                              "}");
+    // subtree of node
+    assert(json_write(tree.get_root()->find("d")->get_key_value_node()) == R"({"e":"f"})");
+    assert(json_write(tree.get_root()->find("a")->get_key_value_node()->get_children().front()) == "1");
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_writer_escapes() {
+    std::cout << "Test writer escapes...";
+    JsonTree tree(R"(["a\"b\\c\/d", "\b\f\n\r\t\u0001\u001f", "é😀", "long text without escapes, \n only one"])");
+    assert(tree.parse());
+    assert(json_write(tree) ==
+           R"(["a\"b\\c/d","\b\f\n\r\t\u0001\u001f","é😀","long text without escapes, \n only one"])");
+    // strings which are not decoded are written as they are
+    JsonTree raw_tree(R"({"kA": "é\/"})");
+    assert(raw_tree.parse({.decode_escapes = false}));
+    assert(json_write(raw_tree) == R"({"kA":"é\/"})");
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_writer_round_trip() {
+    std::cout << "Test writer round trip...";
+    std::string long_string(100, 'x');
+    for (int c = 0; c < 0x20; ++c) {
+        long_string += "\\u00";
+        long_string += "0123456789abcdef"[c >> 4];
+        long_string += "0123456789abcdef"[c & 0x0F];
+        long_string += "\\\"\\\\ é";
+    }
+    const std::vector<std::string> documents{
+        R"({"k1": [12, -3.5e+2, true, null, "a\"b\\"], "k2": {"k\n3": 18446744073709551615}})",
+        R"([0.1, 1e-7, -0.0, 123456789.125, 2.2250738585072014e-308, 1.7976931348623157e308, -2147483649])",
+        R"([[[[]]], {"": {"": ""}}, [{}, {"a": [1, {"b": null}]}]])",
+        "[\"" + long_string + "\"]",
+    };
+    for (const auto& json_data : documents) {
+        for (const auto& options : {JsonTreeParseOptions{}, JsonTreeParseOptions{.lazy_numbers = true}}) {
+            JsonTree tree(json_data);
+            assert(tree.parse(options));
+            for (const auto& write_options : {JsonWriteOptions{}, JsonWriteOptions{.pretty = true}}) {
+                const auto written = json_write(tree, write_options);
+                JsonTree written_tree(written);
+                assert(written_tree.parse());
+                assert_same_nodes(tree, written_tree);
+            }
+        }
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_writer_lenient_lazy_numbers() {
+    std::cout << "Test writer lenient lazy numbers...";
+    // lenient literals are formatted like in eager mode, valid ones keep their text
+    for (const auto& [json_data, expected] : std::vector<std::pair<std::string, std::string>>{
+             {"[007, -.5, 1.e5, 1.]", "[7,-0.5,1e+05,1.0]"},
+             {"[-0, 0.25, 12e-3, 1E+2]", "[-0,0.25,12e-3,1E+2]"},
+         }) {
+        JsonTree tree(json_data);
+        assert(tree.parse({.lazy_numbers = true}));
+        assert(json_write(tree) == expected);
+    }
+    JsonTree eager_tree("[007, -.5, 1.e5, 1.]");
+    assert(eager_tree.parse());
+    assert(json_write(eager_tree) == "[7,-0.5,1e+05,1.0]");
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_writer_fixed_buffer() {
+    std::cout << "Test writer fixed buffer...";
+    JsonTree tree(R"({"name": "first\tsecond", "values": [1, 2.5, 1234567890123]})");
+    assert(tree.parse());
+    const auto expected = json_write(tree);
+    std::vector<char> buffer(expected.size());
+    for (size_t size = 0; size < expected.size(); ++size) {
+        JsonWriter writer(buffer.data(), size);
+        assert(!writer.write(tree));
+        assert(writer.truncated());
+        assert(writer.get_size() <= size);
+        assert(expected.starts_with(writer.view()));
+    }
+    JsonWriter writer(buffer.data(), buffer.size());
+    assert(writer.write(tree));
+    assert(!writer.truncated() && writer.view() == expected);
+    writer.clear();
+    assert(writer.write(tree.get_root()->find("values")->get_key_value_node()));
+    assert(writer.view() == "[1,2.5,1234567890123]");
+    // growable writer appends and keeps memory after clear
+    JsonWriter growable;
+    assert(growable.write(tree) && growable.write(tree));
+    assert(growable.view() == expected + expected);
+    const auto data = growable.data();
+    growable.clear();
+    assert(growable.write(tree) && growable.data() == data && growable.view() == expected);
+    std::cout << "PASSED" << std::endl;
+}